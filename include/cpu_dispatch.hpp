@@ -0,0 +1,146 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @file cpu_dispatch.hpp
+ * @author Rishabh Mukund (rishabh.m96@gmail.com)
+ * @brief Runtime selection of the ISA level used by the filter kernels
+ * @version 1.0
+ * @date 18/10/2026
+ *
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+*/
+
+#pragma once
+
+#include "kf_kernels.hpp"
+
+#include<string>
+
+
+using namespace std;
+
+/**
+ * @brief Instruction set levels the filter kernels are compiled for,
+ *        ordered from oldest to newest
+*/
+enum class IsaLevel {
+    Baseline,
+    SSE42,
+    AVX2,
+    AVX512
+};
+
+
+/**
+ * @brief get name of ISA level (baseline, sse4.2, avx2, avx512)
+ * 
+ * @param level (IsaLevel) - ISA level
+ * 
+ * @return (const char*) - name of ISA level
+*/
+const char* isaName(IsaLevel level);
+
+
+/**
+ * @brief parse ISA level from its name, as accepted by --isa and KF_ISA
+ * 
+ * @param name (string) - name of ISA level
+ * 
+ * @return (IsaLevel) - ISA level
+*/
+IsaLevel parseIsaLevel(const string& name);
+
+
+/**
+ * @brief get highest ISA level supported by both the CPU (via CPUID)
+ *        and this binary
+ * 
+ * @return (IsaLevel) - detected ISA level
+*/
+IsaLevel detectIsaLevel();
+
+
+/**
+ * @brief check if ISA level can run on this CPU and was compiled in
+ * 
+ * @param level (IsaLevel) - ISA level
+ * 
+ * @return (bool) - true if kernels for level can be used
+*/
+bool isaSupported(IsaLevel level);
+
+
+/**
+ * @brief force the ISA level used by the filter kernels
+ * @details An explicit level takes precedence over KF_ISA, which is then
+ *          never read (so a bad KF_ISA value does not get in the way)
+ * 
+ * @param level (IsaLevel) - ISA level, must be supported
+*/
+void setIsaLevel(IsaLevel level);
+
+
+/**
+ * @brief get the ISA level currently in use
+ * @details On first use the level comes from the KF_ISA environment
+ *          variable if set, else from detectIsaLevel()
+ * 
+ * @return (IsaLevel) - active ISA level
+*/
+IsaLevel activeIsaLevel();
+
+
+/**
+ * @brief apply an --isa=<level> (or --isa <level>) command line override
+ * @details The option is removed from argv so callers can parse the rest.
+ *          A command line override takes precedence over KF_ISA.
+ * 
+ * @param argc (int&) - reference of argument count
+ * @param argv (char**) - argument vector
+*/
+void selectIsaFromArgs(int& argc, char** argv);
+
+
+/**
+ * @brief get kernel table for the active ISA level
+ * @details When the level comes from CPUID, the AVX levels run the scalar
+ *          kernels of small filters (fewer than 8 states) on the SSE4.2
+ *          build, which is faster there, and the table name says so (eg.
+ *          "avx2 (scalar: sse4.2 for n<8)"). A level forced by --isa,
+ *          KF_ISA or setIsaLevel() runs its own kernels only.
+ * 
+ * @return (const KernelTable&) - filter kernels
+*/
+const KernelTable& kernels();
+
+
+/**
+ * @brief get kernel table for a given ISA level
+ * @details Always the kernels compiled for level, unlike the level picked
+ *          by CPUID (see kernels())
+ * 
+ * @param level (IsaLevel) - ISA level, must be supported
+ * 
+ * @return (const KernelTable&) - filter kernels
+*/
+const KernelTable& kernels(IsaLevel level);
@@ -4,8 +4,8 @@
  * @file kalman_filter.hpp
  * @author Rishabh Mukund (rishabh.m96@gmail.com)
  * @brief Kalman Filter class declaration
- * @version 2.2
- * @date 14/07/2023
+ * @version 2.5
+ * @date 18/10/2026
  * 
  * 
  * MIT License
@@ -32,6 +32,8 @@
 
 #pragma once
 
+#include "observation_model.hpp"
+
 #include <Eigen/Dense>
 
 
@@ -42,16 +44,17 @@ private:
     int num_states_;        // Number of state parameters
     int num_measurements_;  // Number of independent measurements
 
-    MatrixXd H_;   // Observation Model Matrix
+    ObservationModel H_;   // Observation Model Matrix and its structure
     MatrixXd Q_;   // Process Noise Covariance Matrix
     MatrixXd Pp_;  // Process Covariance Matrix (Predicited)
     MatrixXd Pe_;  // Process Covariance Matrix (Estimated)
     MatrixXd K_;   // Kalman Gain Matrix
-    MatrixXd I_;   // Identity Matrix
 
     VectorXd xp_;  // state vector (Predicited)
     VectorXd xe_;  // state vector (Estimated)
 
+    VectorXd work_;  // scratch space for the predict/update kernels
+
 
 public:
     /**
@@ -65,10 +68,20 @@ public:
 
     /**
      * @brief set obervation matrix (H) of system
+     * @details Selection and diagonal scaled structure in H is detected
+     *          and used by the update step
      * 
      * @param H (MatrixXd) - Obervation matrix 
     */    
     void setObervationMatrix(const MatrixXd& H);
+
+
+    /**
+     * @brief set typed obervation model (H) of system
+     * 
+     * @param H (ObservationModel) - Obervation model
+    */
+    void setObervationMatrix(const ObservationModel& H);
     
 
     /**
@@ -113,6 +126,14 @@ public:
      * @return (VectorXd) - Estimated state vector 
     */
     VectorXd getStateEstimate() const;
+
+
+    /**
+     * @brief get Estimated covariance matrix
+     * 
+     * @return (MatrixXd) - Estimated covariance matrix
+    */
+    MatrixXd getCovarianceEstimate() const;
     
     
     /**
@@ -0,0 +1,132 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @file kf_kernels.hpp
+ * @author Rishabh Mukund (rishabh.m96@gmail.com)
+ * @brief Raw predict/update kernels shared by every ISA build
+ * @version 1.0
+ * @date 18/10/2026
+ *
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+*/
+
+#pragma once
+
+/*
+ * Every kernel works on plain double arrays so the same source can be built
+ * once per ISA level without sharing inline (Eigen) code between the builds.
+ *
+ * Scalar kernels use column-major matrices, same as Eigen::MatrixXd, so
+ * MatrixXd::data() can be passed straight in.
+ *
+ * Batched kernels use a lane-major (SoA) layout: element e of lane l is
+ * stored at [e * count + l], where e is the column-major index of the
+ * element inside the per-lane vector or matrix.
+*/
+
+struct KernelTable {
+    const char* name;  // ISA level the table was compiled for
+
+    /**
+     * @brief xp = A * xe + B * u,  Pp = A * Pe * A' + Q
+     * @details work needs n * n doubles
+    */
+    void (*predict)(int n, const double* A, const double* B, double u,
+        const double* Q, const double* xe, const double* Pe,
+        double* xp, double* Pp, double* work);
+
+    /**
+     * @brief K = Pp * H' * (H * Pp * H' + R)^-1,  xe = xp + K * (y - H * xp),
+     *        Pe = (I - K * H) * Pp
+     * @details work needs 2 * n * m + 2 * m * m + m doubles
+     *
+     * @return (int) - 0 on success, non zero if innovation covariance is singular
+    */
+    int (*update)(int n, int m, const double* H, const double* R,
+        const double* y, const double* xp, const double* Pp,
+        double* xe, double* Pe, double* K, double* work);
+
+    /**
+     * @brief Same as update for an H whose row a is scale[a] times state
+     *        index[a], gathering rows and columns of Pp instead of
+     *        multiplying by H
+     * @details scale may be nullptr for a pure selection (all ones).
+     *          work needs 2 * n * m + 2 * m * m + m doubles
+     *
+     * @return (int) - 0 on success, non zero if innovation covariance is singular
+    */
+    int (*updateIndexed)(int n, int m, const int* index, const double* scale,
+        const double* R, const double* y, const double* xp, const double* Pp,
+        double* xe, double* Pe, double* K, double* work);
+
+    /**
+     * @brief In place predict of count lanes, each with its own A and Q
+     * @details A, Q, P are n * n lane-major, x is n lane-major,
+     *          work needs (n + n * n) * count doubles
+    */
+    void (*predictBatch)(int n, int count, const double* A, const double* Q,
+        double* x, double* P, double* work);
+
+    /**
+     * @brief In place scalar measurement update of count lanes sharing h and r
+     * @details h is the (1 x n) observation row, y has one value per lane.
+     *          innov and s (optional, may be nullptr) receive the innovation
+     *          and its variance per lane. work needs (2 * n + 2) * count doubles
+    */
+    void (*updateBatch)(int n, int count, const double* h, double r,
+        const double* y, double* x, double* P, double* innov, double* s,
+        double* work);
+
+    /**
+     * @brief In place state only predict and update of count lanes sharing
+     *        A, K and H: xp = A * x,  x = xp + K * (y - H * xp)
+     * @details A, K, H are column-major, x is n lane-major, y is m lane-major
+     *          (nullptr for a predict only step). work needs (n + m) * count
+     *          doubles
+    */
+    void (*propagateShared)(int n, int m, int count, const double* A,
+        const double* K, const double* H, const double* y, double* x,
+        double* work);
+
+    /**
+     * @brief IMM mixing into count lanes from the first models lanes:
+     *        x0_j = sum_i W(i, j) x_i,
+     *        P0_j = sum_i W(i, j) (P_i + (x_i - x0_j) * (x_i - x0_j)')
+     * @details x, P, x0, P0 are lane-major, W(i, j) is stored at
+     *          [i * count + j]
+    */
+    void (*mixBatch)(int n, int models, int count, const double* W,
+        const double* x, const double* P, double* x0, double* P0);
+};
+
+
+extern const KernelTable kBaselineKernels;
+#ifdef KF_HAVE_SSE42
+extern const KernelTable kSse42Kernels;
+#endif
+#ifdef KF_HAVE_AVX2
+extern const KernelTable kAvx2Kernels;
+#endif
+#ifdef KF_HAVE_AVX512
+extern const KernelTable kAvx512Kernels;
+#endif
@@ -0,0 +1,158 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @file observation_model.hpp
+ * @author Rishabh Mukund (rishabh.m96@gmail.com)
+ * @brief Observation model (H) with its structure
+ * @version 1.0
+ * @date 18/10/2026
+ *
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+*/
+
+#pragma once
+
+#include "kf_kernels.hpp"
+
+#include<Eigen/Dense>
+#include<vector>
+
+
+using namespace Eigen;
+using namespace std;
+
+/**
+ * @brief Observation model (H) tagged with its structure so the update step
+ *        can skip the multiplications by zero
+ * @details Selection: row a picks state indices()[a] (H(a, i) = 1).
+ *          DiagonalScaled: row a is scales()[a] times state indices()[a].
+ *          Dense: any other H.
+*/
+class ObservationModel {
+public:
+    enum class Type {
+        Dense,
+        Selection,
+        DiagonalScaled
+    };
+
+private:
+    Type type_;
+    MatrixXd H_;           // dense form, kept for every type
+    vector<int> indices_;  // observed state per row (Selection, DiagonalScaled)
+    VectorXd scales_;      // scale per row (DiagonalScaled, 1 for Selection)
+
+    ObservationModel(Type type, const MatrixXd& H, const vector<int>& indices,
+        const VectorXd& scales);
+
+
+public:
+    /**
+     * @brief dense observation model
+     * 
+     * @param H (MatrixXd) - Obervation matrix
+     * 
+     * @return (ObservationModel) - dense model
+    */
+    static ObservationModel dense(const MatrixXd& H);
+
+
+    /**
+     * @brief observation model picking state components directly
+     * 
+     * @param num_states (int) - Number of state parameters
+     * @param indices (vector<int>) - observed state index per measurement
+     * 
+     * @return (ObservationModel) - selection model
+    */
+    static ObservationModel selection(int num_states, const vector<int>& indices);
+
+
+    /**
+     * @brief observation model picking scaled state components
+     * 
+     * @param num_states (int) - Number of state parameters
+     * @param indices (vector<int>) - observed state index per measurement
+     * @param scales (VectorXd) - scale per measurement
+     * 
+     * @return (ObservationModel) - diagonal scaled model
+    */
+    static ObservationModel diagonalScaled(int num_states, const vector<int>& indices,
+        const VectorXd& scales);
+
+
+    /**
+     * @brief observation model of the most specific type that matches H
+     * 
+     * @param H (MatrixXd) - Obervation matrix
+     * 
+     * @return (ObservationModel) - selection, diagonal scaled or dense model
+    */
+    static ObservationModel fromMatrix(const MatrixXd& H);
+
+
+    /**
+     * @brief get structure of the model
+     * 
+     * @return (Type) - model type
+    */
+    Type type() const;
+
+
+    /**
+     * @brief get dense form of the model
+     * 
+     * @return (MatrixXd) - Obervation matrix
+    */
+    const MatrixXd& matrix() const;
+
+
+    /**
+     * @brief get observed state index per measurement (not for Dense)
+     * 
+     * @return (vector<int>) - state indices
+    */
+    const vector<int>& indices() const;
+
+
+    /**
+     * @brief get scale per measurement (not for Dense)
+     * 
+     * @return (VectorXd) - scales
+    */
+    const VectorXd& scales() const;
+
+
+    /**
+     * @brief run the update kernel that matches the structure of the model
+     * @details Arguments as KernelTable::update, work needs
+     *          2 * n * m + 2 * m * m + m doubles
+     * 
+     * @param kernels (KernelTable) - kernels of the active ISA level
+     * 
+     * @return (int) - 0 on success, non zero if innovation covariance is singular
+    */
+    int update(const KernelTable& kernels, const double* R, const double* y,
+        const double* xp, const double* Pp, double* xe, double* Pe, double* K,
+        double* work) const;
+};
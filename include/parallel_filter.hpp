@@ -0,0 +1,177 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @file parallel_filter.hpp
+ * @author Rishabh Mukund (rishabh.m96@gmail.com)
+ * @brief Parallel-in-time Kalman filter and smoother for offline logs
+ * @version 1.0
+ * @date 18/10/2026
+ *
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+*/
+
+#pragma once
+
+#include "thread_pool.hpp"
+
+#include<Eigen/Dense>
+#include<vector>
+
+
+using namespace Eigen;
+using namespace std;
+
+/**
+ * @brief One predict (and optional update) step of an offline log,
+ *        same arguments as KalmanFilter::predict and KalmanFilter::update
+*/
+struct FilterStep {
+    MatrixXd A;  // State transition matrix
+    MatrixXd B;  // Control input matrix (empty for no control)
+    VectorXd u;  // Control vector (empty for no control)
+    VectorXd y;  // Measured state variables (empty for a predict only step)
+    MatrixXd R;  // Observation noise covariance matrix
+    MatrixXd H;  // Obervation matrix (empty to use the filter's)
+};
+
+
+/**
+ * @brief Kalman filter over a whole log at once, computed as a chunked scan
+ *        of associative elements (Sarkka & Garcia-Fernandez, "Temporal
+ *        Parallelization of Bayesian Smoothers", 2021)
+ * @details The log of n steps is split in one chunk per thread (T chunks).
+ *          Chunk 0 runs the sequential filter while every other chunk
+ *          reduces its steps to one element. The chunk elements are then
+ *          combined by a tree scan on the pool and those chunks filter their
+ *          steps again from the estimate before. The span is O(n/T + log T)
+ *          and the work about twice the sequential filter, with one thread
+ *          it is the sequential filter. The smoother runs the same way
+ *          backwards. Gives the same estimates as running
+ *          KalmanFilter::predict and KalmanFilter::update over the steps, up
+ *          to rounding.
+*/
+class ParallelKalmanFilter {
+private:
+    int num_states_;        // Number of state parameters
+    int num_measurements_;  // Number of independent measurements
+
+    MatrixXd H_;   // Observation Model Matrix
+    MatrixXd Q_;   // Process Noise Covariance Matrix
+    MatrixXd Pi_;  // Initial Process Covariance Matrix
+    VectorXd xi_;  // Initial state vector
+
+    ThreadPool pool_;
+
+    vector<VectorXd> xe_;  // state vectors (Estimated) after each step
+    vector<MatrixXd> Pe_;  // Process Covariance Matrices (Estimated)
+    vector<VectorXd> xs_;  // state vectors (Smoothed)
+    vector<MatrixXd> Ps_;  // Process Covariance Matrices (Smoothed)
+    vector<MatrixXd> Gs_;  // smoother gains, one per step
+
+    void checkStep(const FilterStep& step) const;
+
+
+public:
+    /**
+     * @brief Constructor for ParallelKalmanFilter class
+     * 
+     * @param num_states (int) - Number of state parameters
+     * @param num_measurements (int) - Number of independent measurements
+     * @param num_threads (int) - Number of threads, 0 uses the hardware concurrency
+    */
+    ParallelKalmanFilter(int num_states, int num_measurements, int num_threads = 0);
+
+
+    /**
+     * @brief set obervation matrix (H) of system
+     * 
+     * @param H (MatrixXd) - Obervation matrix 
+    */
+    void setObervationMatrix(const MatrixXd& H);
+
+
+    /**
+     * @brief set initial state of the system
+     * 
+     * @param xi (VectorXd) - Initial state vector
+     * @param Pi (MatrixXd) - Initial Process Covariance Matrix
+    */
+    void setInitState(const VectorXd& xi, const MatrixXd& Pi);
+
+
+    /**
+     * @brief set noise covariance matrix (Q) of system
+     * 
+     * @param Q (MatrixXd) - Noise covariance matrix
+    */
+    void setNoiseCovariance(const MatrixXd& Q);
+
+
+    /**
+     * @brief run the filter over all steps of a log
+     * 
+     * @param steps (vector<FilterStep>) - predict/update steps in time order
+    */
+    void filter(const vector<FilterStep>& steps);
+
+
+    /**
+     * @brief run the Rauch-Tung-Striebel smoother as a reverse scan over
+     *        the filtered estimates
+     * 
+     * @param steps (vector<FilterStep>) - same steps last given to filter()
+    */
+    void smooth(const vector<FilterStep>& steps);
+
+
+    /**
+     * @brief get Estimated state vectors, one per step
+     * 
+     * @return (vector<VectorXd>) - Estimated state vectors
+    */
+    const vector<VectorXd>& getStateEstimates() const;
+
+
+    /**
+     * @brief get Estimated Process Covariance Matrices, one per step
+     * 
+     * @return (vector<MatrixXd>) - Estimated Process Covariance Matrices
+    */
+    const vector<MatrixXd>& getCovarianceEstimates() const;
+
+
+    /**
+     * @brief get Smoothed state vectors, one per step
+     * 
+     * @return (vector<VectorXd>) - Smoothed state vectors
+    */
+    const vector<VectorXd>& getSmoothedStates() const;
+
+
+    /**
+     * @brief get Smoothed Process Covariance Matrices, one per step
+     * 
+     * @return (vector<MatrixXd>) - Smoothed Process Covariance Matrices
+    */
+    const vector<MatrixXd>& getSmoothedCovariances() const;
+};
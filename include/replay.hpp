@@ -0,0 +1,139 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @file replay.hpp
+ * @author Rishabh Mukund (rishabh.m96@gmail.com)
+ * @brief Timestamp driven replay of sensor logs with latency measurement
+ * @version 1.0
+ * @date 18/10/2026
+ *
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+*/
+
+#pragma once
+
+#include<cstdint>
+#include<functional>
+#include<string>
+#include<vector>
+
+
+using namespace std;
+
+/**
+ * @brief Single measurement read from a sensor log
+*/
+struct SensorEvent {
+    double timestamp;  // sensor timestamp (ms)
+    double value;      // measured position
+    int sensor;        // 1 based index of the log the event came from
+};
+
+
+/**
+ * @brief Playback and disturbance settings of a replay
+*/
+struct ReplayConfig {
+    double speed = 1.0;            // playback rate vs timestamps, <= 0 is max speed
+    double jitter_ms = 0;          // stddev of gaussian delay added to each arrival
+    double burst_prob = 0;         // chance an event starts a burst
+    int burst_len = 0;             // events held back and released together
+    double reorder_prob = 0;       // chance an event is swapped with the next one
+    double deadline_ms = 0;        // estimate deadline after arrival, 0 disables
+    size_t queue_capacity = 1024;  // pending events before arrivals are dropped
+    unsigned seed = 0;             // seed for jitter, bursts and reordering
+};
+
+
+/**
+ * @brief Counters and latency samples of a replay
+*/
+struct ReplayStats {
+    size_t delivered = 0;        // events that reached the queue
+    size_t processed = 0;        // events run through the pipeline
+    size_t dropped = 0;          // arrivals lost because the queue was full
+    size_t late = 0;             // arrivals older than an already processed event
+    size_t deadline_misses = 0;  // estimates produced after the deadline
+    double wall_time_s = 0;      // duration of the replay
+    vector<double> latency_us;   // arrival to estimate latency per processed event,
+                                 // at max speed dequeue to estimate (pipeline only)
+
+    /**
+     * @brief get latency percentile
+     * 
+     * @param p (double) - percentile in [0, 100]
+     * 
+     * @return (double) - latency in microseconds, 0 if nothing was processed
+    */
+    double percentile(double p) const;
+
+    /**
+     * @brief get mean latency
+     * 
+     * @return (double) - latency in microseconds, 0 if nothing was processed
+    */
+    double mean() const;
+};
+
+
+/**
+ * @brief Load and merge any number of sensor logs ordered by timestamp
+ * @details Data in files should be comma seperated values. (eg time, pos)
+ * 
+ * @param filenames (vector<string>) - File paths of the logs, sensor i + 1 is filenames[i]
+ * 
+ * @return vector<SensorEvent> - merged events
+*/
+vector<SensorEvent> loadSensorLogs(const vector<string>& filenames);
+
+
+class ReplayHarness {
+private:
+    ReplayConfig config_;
+
+public:
+    /**
+     * @brief Constructor for ReplayHarness class
+     * 
+     * @param config (ReplayConfig) - playback and disturbance settings
+    */
+    explicit ReplayHarness(const ReplayConfig& config);
+
+
+    /**
+     * @brief play events according to their timestamps and feed a pipeline
+     * @details A producer thread delivers events at their (scaled and
+     *          disturbed) arrival time into a bounded queue, the calling
+     *          thread pops them and runs the pipeline. Arrivals older than
+     *          the newest processed event are counted as late and skipped
+     *          since a forward filter cannot use them.
+     * 
+     * @param events (vector<SensorEvent>) - events ordered by timestamp
+     * @param pipeline (function) - called for each event, returns once the
+     *                              estimate for it is available
+     * 
+     * @return (ReplayStats) - counters and latency samples
+    */
+    ReplayStats run(const vector<SensorEvent>& events,
+        const function<void(const SensorEvent&)>& pipeline);
+};
@@ -0,0 +1,248 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @file shm_ring.hpp
+ * @author Rishabh Mukund (rishabh.m96@gmail.com)
+ * @brief Seqlocked POSIX shared memory ring for publishing filter estimates
+ * @version 1.0
+ * @date 18/10/2026
+ *
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+*/
+
+#pragma once
+
+#include<Eigen/Dense>
+#include<atomic>
+#include<cstddef>
+#include<cstdint>
+#include<string>
+
+
+using namespace Eigen;
+using namespace std;
+
+/*
+ * Shared memory layout, one writer and any number of readers:
+ *
+ *   ShmRingHeader | slot 0 | slot 1 | ... | slot (slot_count - 1)
+ *
+ * Every slot is slot_size bytes (a multiple of 64) and holds
+ *
+ *   atomic<uint64_t> seq | double timestamp | uint64_t track_id |
+ *   double state[state_dim] | double covariance[state_dim * state_dim]
+ *
+ * with the covariance present only when has_covariance is set. Record k
+ * goes to slot k % slot_count. The writer sets seq to 2k + 1 while it
+ * copies the record in and to 2k + 2 once it is complete, so a reader
+ * that sees the same even seq before and after copying the slot out has
+ * a consistent record, and any larger seq means the record was overwritten.
+*/
+
+static_assert(atomic<uint64_t>::is_always_lock_free,
+    "shared memory ring needs lock free 64 bit atomics");
+
+struct ShmRingHeader {
+    uint64_t magic;             // kShmRingMagic once the header is filled in
+    uint32_t version;           // kShmRingVersion of the writer
+    uint32_t slot_count;        // number of records kept
+    uint32_t state_dim;         // number of state parameters per record
+    uint32_t has_covariance;    // 1 if records carry the covariance matrix
+    uint64_t slot_size;         // bytes per slot
+    int64_t writer_pid;         // process id of the publisher
+    alignas(64) atomic<uint64_t> write_index;  // number of records published
+};
+
+constexpr uint64_t kShmRingMagic = 0x4b46455354524e47;  // "KFESTRNG"
+constexpr uint32_t kShmRingVersion = 2;
+
+
+/**
+ * @brief One estimate copied out of the ring
+*/
+struct EstimateRecord {
+    uint64_t index;       // position of the record in the stream
+    double timestamp;     // time stamp given by the publisher
+    uint64_t track_id;    // track the estimate belongs to
+    VectorXd state;       // state estimate
+    MatrixXd covariance;  // covariance estimate, empty if not published
+};
+
+
+/**
+ * @brief Writes estimates into a named POSIX shared memory ring
+ * @details The ring is created by the constructor and unlinked by the
+ *          destructor, readers that already mapped it keep their mapping.
+ *          A ring of the same name is only replaced if the process that
+ *          published it has exited, otherwise the constructor fails. Publishing copies the record straight into
+ *          the mapped slot, it does not allocate, lock or make a system
+ *          call. Only one thread may publish to a ring.
+*/
+class ShmPublisher {
+private:
+    string name_;           // shared memory object name, eg. "/kf_estimates"
+    size_t bytes_;          // size of the mapping
+    ShmRingHeader* header_; // start of the mapping
+    unsigned char* slots_;  // first slot
+    uint64_t next_;         // index of the next record
+
+public:
+    /**
+     * @brief Constructor for ShmPublisher class
+     * 
+     * @param name (string) - shared memory object name, starting with '/'
+     * @param slot_count (int) - number of records kept for readers
+     * @param state_dim (int) - number of state parameters per record
+     * @param with_covariance (bool) - publish the covariance matrix as well
+    */
+    ShmPublisher(const string& name, int slot_count, int state_dim,
+        bool with_covariance = false);
+
+
+    ~ShmPublisher();
+
+    ShmPublisher(const ShmPublisher&) = delete;
+    ShmPublisher& operator=(const ShmPublisher&) = delete;
+
+
+    /**
+     * @brief publish one estimate
+     * 
+     * @param timestamp (double) - time stamp of the estimate
+     * @param track_id (uint64_t) - track the estimate belongs to
+     * @param x (double*) - state_dim state values
+     * @param P (double*) - state_dim * state_dim column-major covariance,
+     *                      required if the ring has covariance, else ignored
+    */
+    void publish(double timestamp, uint64_t track_id, const double* x,
+        const double* P = nullptr);
+
+
+    /**
+     * @brief publish one estimate
+     * 
+     * @param timestamp (double) - time stamp of the estimate
+     * @param track_id (uint64_t) - track the estimate belongs to
+     * @param x (VectorXd) - state estimate
+     * @param P (MatrixXd) - covariance estimate
+    */
+    void publish(double timestamp, uint64_t track_id, const VectorXd& x,
+        const MatrixXd& P);
+
+
+    /**
+     * @brief get number of records published so far
+     * 
+     * @return (uint64_t) - number of records
+    */
+    uint64_t published() const;
+};
+
+
+/**
+ * @brief Maps a ring created by ShmPublisher read only and copies records out
+ * @details Reading never blocks the publisher and never waits on it. A
+ *          reader that falls more than slot_count records behind skips to
+ *          the oldest record still in the ring and counts the records it
+ *          lost.
+*/
+class ShmReader {
+private:
+    size_t bytes_;                // size of the mapping
+    const ShmRingHeader* header_; // start of the mapping
+    const unsigned char* slots_;  // first slot
+    uint64_t cursor_;             // index of the next record to return
+    uint64_t overruns_;           // records overwritten before they were read
+
+    int readSlot(uint64_t index, EstimateRecord& record) const;
+
+public:
+    /**
+     * @brief Constructor for ShmReader class
+     * 
+     * @param name (string) - shared memory object name, starting with '/'
+     * @param from_oldest (bool) - start at the oldest record in the ring
+     *                             instead of the next one published
+    */
+    explicit ShmReader(const string& name, bool from_oldest = false);
+
+
+    ~ShmReader();
+
+    ShmReader(const ShmReader&) = delete;
+    ShmReader& operator=(const ShmReader&) = delete;
+
+
+    /**
+     * @brief get number of state parameters per record
+     * 
+     * @return (int) - state dimension
+    */
+    int stateDim() const;
+
+
+    /**
+     * @brief check if records carry the covariance matrix
+     * 
+     * @return (bool) - true if covariance is published
+    */
+    bool hasCovariance() const;
+
+
+    /**
+     * @brief get number of records published so far
+     * 
+     * @return (uint64_t) - number of records
+    */
+    uint64_t published() const;
+
+
+    /**
+     * @brief get number of records skipped because the reader fell behind
+     * 
+     * @return (uint64_t) - number of records
+    */
+    uint64_t overruns() const;
+
+
+    /**
+     * @brief copy out the most recently published record
+     * 
+     * @param record (EstimateRecord) - receives the record
+     * 
+     * @return (bool) - false if nothing was published yet, or the only
+     *                  published record is being written
+    */
+    bool latest(EstimateRecord& record) const;
+
+
+    /**
+     * @brief copy out the next record after the previous call
+     * 
+     * @param record (EstimateRecord) - receives the record
+     * 
+     * @return (bool) - false if no new record was published, or the
+     *                  publisher is writing it right now (poll again)
+    */
+    bool next(EstimateRecord& record);
+};
@@ -0,0 +1,102 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @file thread_pool.hpp
+ * @author Rishabh Mukund (rishabh.m96@gmail.com)
+ * @brief Fixed size thread pool with a blocking parallel for
+ * @version 1.0
+ * @date 18/10/2026
+ *
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+*/
+
+#pragma once
+
+#include<atomic>
+#include<condition_variable>
+#include<cstdint>
+#include<exception>
+#include<functional>
+#include<mutex>
+#include<thread>
+#include<vector>
+
+
+using namespace std;
+
+class ThreadPool {
+private:
+    vector<thread> workers_;
+    mutex lock_;
+    condition_variable wake_;   // signals a new job (or stop) to the workers
+    condition_variable done_;   // signals the caller that all workers finished
+
+    const function<void(size_t, size_t)>* body_;  // current job
+    size_t end_;                // end of current index range
+    size_t chunk_;              // indices handed out per claim
+    atomic<size_t> next_;       // next unclaimed index
+    uint64_t generation_;       // incremented for every job
+    int pending_;               // workers still running the current job
+    bool stop_;
+    exception_ptr error_;       // first exception thrown by the job
+
+    void workerLoop();
+    void runChunks();
+
+public:
+    /**
+     * @brief Constructor for ThreadPool class
+     * 
+     * @param num_threads (int) - Number of threads including the caller,
+     *                            0 uses the hardware concurrency
+    */
+    explicit ThreadPool(int num_threads = 0);
+
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+
+    /**
+     * @brief get number of threads running jobs, including the caller
+     * 
+     * @return (int) - number of threads
+    */
+    int size() const;
+
+
+    /**
+     * @brief run body over [begin, end) split in chunks across the pool
+     * @details The calling thread takes part and the call returns once
+     *          every chunk is done. The first exception thrown by body is
+     *          rethrown here.
+     * 
+     * @param begin (size_t) - first index
+     * @param end (size_t) - one past the last index
+     * @param body (function) - called with sub ranges [first, last)
+    */
+    void parallelFor(size_t begin, size_t end,
+        const function<void(size_t, size_t)>& body);
+};
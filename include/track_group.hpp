@@ -0,0 +1,171 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @file track_group.hpp
+ * @author Rishabh Mukund (rishabh.m96@gmail.com)
+ * @brief Group of tracks sharing one covariance and gain sequence
+ * @version 1.0
+ * @date 18/10/2026
+ *
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+*/
+
+#pragma once
+
+#include<Eigen/Dense>
+#include<vector>
+
+
+using namespace Eigen;
+using namespace std;
+
+/**
+ * @brief Tracks that share the same model (A, Q, H, R), initial covariance
+ *        and timestamp schedule
+ * @details Pp, Pe and K do not depend on measurement values, so they are
+ *          the same for every track in such a group. The group runs one
+ *          Riccati recursion per step and the member tracks only do the
+ *          state update, with all states packed lane-major (component i of
+ *          track t at [i * size() + t]).
+*/
+class SharedCovarianceGroup {
+private:
+    int num_states_;        // Number of state parameters
+    int num_measurements_;  // Number of independent measurements
+    int num_tracks_;        // Number of member tracks
+
+    MatrixXd H_;   // Observation Model Matrix
+    MatrixXd Q_;   // Process Noise Covariance Matrix
+    MatrixXd Pp_;  // Process Covariance Matrix (Predicited), shared
+    MatrixXd Pe_;  // Process Covariance Matrix (Estimated), shared
+    MatrixXd K_;   // Kalman Gain Matrix, shared
+
+    VectorXd xz_;    // zero state and control fed to the Riccati kernels
+    VectorXd xd_;    // discarded state output of the Riccati kernels
+    VectorXd yz_;    // zero measurement fed to the Riccati kernels
+    VectorXd work_;  // scratch space for the Riccati kernels
+
+    vector<double> x_;      // state vectors (Estimated) of all tracks, lane-major
+    vector<double> xwork_;  // scratch space for the state kernel
+    bool started_;          // true once a step ran, tracks can no longer be added
+
+    void predictCovariance(const MatrixXd& A);
+
+
+public:
+    /**
+     * @brief Constructor for SharedCovarianceGroup class
+     * 
+     * @param num_states (int) - Number of state parameters
+     * @param num_measurements (int) - Number of independent measurements
+    */
+    SharedCovarianceGroup(int num_states, int num_measurements);
+
+
+    /**
+     * @brief set obervation matrix (H) of system
+     * 
+     * @param H (MatrixXd) - Obervation matrix 
+    */
+    void setObervationMatrix(const MatrixXd& H);
+
+
+    /**
+     * @brief set noise covariance matrix (Q) of system
+     * 
+     * @param Q (MatrixXd) - Noise covariance matrix
+    */
+    void setNoiseCovariance(const MatrixXd& Q);
+
+
+    /**
+     * @brief set initial Process Covariance Matrix shared by all tracks
+     * 
+     * @param Pi (MatrixXd) - Initial Process Covariance Matrix
+    */
+    void setInitCovariance(const MatrixXd& Pi);
+
+
+    /**
+     * @brief add a track to the group, only before the first step
+     * 
+     * @param xi (VectorXd) - Initial state vector
+     * 
+     * @return (int) - index of the track in the group
+    */
+    int addTrack(const VectorXd& xi);
+
+
+    /**
+     * @brief run predict and update for every track
+     * @details y holds the measurements lane-major, measurement a of
+     *          track t at y[a * size() + t]
+     * 
+     * @param A (MatrixXd) - State transition matrix
+     * @param y (vector<double>) - Measured state variables of all tracks
+     * @param R (MatrixXd) - Observation noise covariance matrix
+    */
+    void step(const MatrixXd& A, const vector<double>& y, const MatrixXd& R);
+
+
+    /**
+     * @brief run predict only (no measurement at this time) for every track
+     * 
+     * @param A (MatrixXd) - State transition matrix
+    */
+    void predict(const MatrixXd& A);
+
+
+    /**
+     * @brief get number of tracks in the group
+     * 
+     * @return (int) - number of tracks
+    */
+    int size() const;
+
+
+    /**
+     * @brief get Estimated state vector of a track
+     * 
+     * @param track (int) - index of the track
+     * 
+     * @return (VectorXd) - Estimated state vector
+    */
+    VectorXd getStateEstimate(int track) const;
+
+
+    /**
+     * @brief get Estimated Process Covariance Matrix shared by all tracks
+     * 
+     * @return (MatrixXd) - Estimated Process Covariance Matrix
+    */
+    const MatrixXd& getCovarianceEstimate() const;
+
+
+    /**
+     * @brief get Kalman Gain Matrix of the last update
+     * 
+     * @return (MatrixXd) - Kalman Gain Matrix
+    */
+    const MatrixXd& getGain() const;
+};
@@ -0,0 +1,258 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @file track_pool.hpp
+ * @author Rishabh Mukund (rishabh.m96@gmail.com)
+ * @brief Preallocated track store with generation counted handles
+ * @version 1.0
+ * @date 18/10/2026
+ *
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+*/
+
+#pragma once
+
+#include "observation_model.hpp"
+
+#include<Eigen/Dense>
+#include<cstddef>
+#include<cstdint>
+#include<new>
+#include<vector>
+
+
+using namespace Eigen;
+using namespace std;
+
+/**
+ * @brief Handle to a track in a TrackPool, stale once the track is destroyed
+*/
+struct TrackHandle {
+    uint32_t slot;        // index in the pool's handle table
+    uint32_t generation;  // generation of the slot when the track was created, 0 is never valid
+};
+
+
+/**
+ * @brief Allocator handing out 64 byte (cache line) aligned storage
+*/
+template<typename T>
+struct CacheLineAllocator {
+    using value_type = T;
+    static constexpr size_t kAlign = 64;
+
+    CacheLineAllocator() = default;
+    template<typename U>
+    CacheLineAllocator(const CacheLineAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), align_val_t(kAlign)));
+    }
+
+    void deallocate(T* p, size_t) {
+        ::operator delete(p, align_val_t(kAlign));
+    }
+
+    template<typename U>
+    bool operator==(const CacheLineAllocator<U>&) const { return true; }
+    template<typename U>
+    bool operator!=(const CacheLineAllocator<U>&) const { return false; }
+};
+
+
+/**
+ * @brief Fixed capacity store of Kalman filter tracks sharing one model (H, Q)
+ * @details Every track lives in a fixed size block of one arena allocated
+ *          in the constructor (xe, Pe, xp, Pp, K), aligned to and padded
+ *          to whole 64 byte cache lines. Live tracks are kept
+ *          compacted at the front of the arena, destroy moves the last
+ *          track into the hole, so iterating over 0..size() - 1 walks
+ *          contiguous memory. Handles go through a slot table with a
+ *          generation count and a free list, create and destroy are O(1)
+ *          and do not allocate.
+*/
+class TrackPool {
+private:
+    int num_states_;        // Number of state parameters
+    int num_measurements_;  // Number of independent measurements
+    int capacity_;          // Maximum number of live tracks
+    int stride_;            // doubles per track block
+    int size_;              // Number of live tracks
+
+    ObservationModel H_;   // Observation Model Matrix and its structure
+    MatrixXd Q_;           // Process Noise Covariance Matrix
+
+    vector<double, CacheLineAllocator<double>> arena_;  // track blocks, live tracks first
+    vector<uint32_t> generation_;  // current generation per handle slot
+    vector<uint32_t> dense_of_;    // handle slot -> track block index
+    vector<uint32_t> slot_of_;     // track block index -> handle slot
+    vector<uint32_t> next_free_;   // free list links between handle slots
+    uint32_t free_head_;           // first free handle slot
+
+    vector<double> work_;  // scratch space for the predict/update kernels
+
+    double* block(int index);
+    const double* block(int index) const;
+    int indexOf(TrackHandle track) const;
+
+
+public:
+    /**
+     * @brief Constructor for TrackPool class
+     * 
+     * @param num_states (int) - Number of state parameters
+     * @param num_measurements (int) - Number of independent measurements
+     * @param capacity (int) - Maximum number of live tracks
+    */
+    TrackPool(int num_states, int num_measurements, int capacity);
+
+
+    /**
+     * @brief set obervation matrix (H) of all tracks
+     * 
+     * @param H (MatrixXd) - Obervation matrix 
+    */
+    void setObervationMatrix(const MatrixXd& H);
+
+
+    /**
+     * @brief set typed obervation model (H) of all tracks
+     * 
+     * @param H (ObservationModel) - Obervation model
+    */
+    void setObervationMatrix(const ObservationModel& H);
+
+
+    /**
+     * @brief set noise covariance matrix (Q) of all tracks
+     * 
+     * @param Q (MatrixXd) - Noise covariance matrix
+    */
+    void setNoiseCovariance(const MatrixXd& Q);
+
+
+    /**
+     * @brief create a track in a free slot
+     * 
+     * @param xi (VectorXd) - Initial state vector
+     * @param Pi (MatrixXd) - Initial Process Covariance Matrix
+     * 
+     * @return (TrackHandle) - handle of the new track
+    */
+    TrackHandle create(const VectorXd& xi, const MatrixXd& Pi);
+
+
+    /**
+     * @brief destroy a track and recycle its slot
+     * 
+     * @param track (TrackHandle) - handle of a live track
+    */
+    void destroy(TrackHandle track);
+
+
+    /**
+     * @brief check if a handle refers to a live track
+     * 
+     * @param track (TrackHandle) - handle to check
+     * 
+     * @return (bool) - true if the track is alive
+    */
+    bool valid(TrackHandle track) const;
+
+
+    /**
+     * @brief run predict step of one track
+     * 
+     * @param track (TrackHandle) - handle of a live track
+     * @param A (MatrixXd) - State transition matrix
+     * @param B (MatrixXd) - Control input matrix
+     * @param u (VectorXd) - Control vector
+    */
+    void predict(TrackHandle track, const MatrixXd& A, const MatrixXd& B, const VectorXd& u);
+
+
+    /**
+     * @brief run predict step of every live track, in memory order
+     * 
+     * @param A (MatrixXd) - State transition matrix
+     * @param B (MatrixXd) - Control input matrix
+     * @param u (VectorXd) - Control vector
+    */
+    void predictAll(const MatrixXd& A, const MatrixXd& B, const VectorXd& u);
+
+
+    /**
+     * @brief run update step of one track
+     * 
+     * @param track (TrackHandle) - handle of a live track
+     * @param y (VectorXd) - Measured state variables
+     * @param R (MatrixXd) - Observation noise covariance matrix  
+    */
+    void update(TrackHandle track, const VectorXd& y, const MatrixXd& R);
+
+
+    /**
+     * @brief get Estimated state vector of a track, valid until the pool changes
+     * 
+     * @param track (TrackHandle) - handle of a live track
+     * 
+     * @return (Map<const VectorXd>) - Estimated state vector
+    */
+    Map<const VectorXd> getStateEstimate(TrackHandle track) const;
+
+
+    /**
+     * @brief get Predicited state vector of a track, valid until the pool changes
+     * 
+     * @param track (TrackHandle) - handle of a live track
+     * 
+     * @return (Map<const VectorXd>) - Predicited state vector
+    */
+    Map<const VectorXd> getStatePredicited(TrackHandle track) const;
+
+
+    /**
+     * @brief get handle of the i-th live track, for iterating over the pool
+     * 
+     * @param index (int) - index in [0, size())
+     * 
+     * @return (TrackHandle) - handle of the track
+    */
+    TrackHandle handleAt(int index) const;
+
+
+    /**
+     * @brief get number of live tracks
+     * 
+     * @return (int) - number of live tracks
+    */
+    int size() const;
+
+
+    /**
+     * @brief get maximum number of live tracks
+     * 
+     * @return (int) - capacity of the pool
+    */
+    int capacity() const;
+};
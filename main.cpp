@@ -8,6 +8,11 @@
 
 #include "kalman_filter.hpp"
 #include "utils.hpp"
+#include "cpu_dispatch.hpp"
+#include "parallel_filter.hpp"
+#include "track_group.hpp"
+#include "imm_filter.hpp"
+#include "track_pool.hpp"
 
 #include<vector>
 #include<map>
@@ -15,6 +20,7 @@
 #include<string>
 #include<iostream>
 #include<memory>
+#include<algorithm>
 
 
 using namespace std;
@@ -189,11 +195,412 @@ void task2() {
 }
 
 
-int main() {
+void task3() {
+    int num_states = 2;        // x_pos, x_vel
+    int num_measurements = 1;  // xm_pos
+
+    string filename = "../data/cam_data1.txt";
+
+    vector<double> timestamps;
+    vector<double> gt_pos;
+    vector<double> error;
+    double stddev = 1;        // standard deviation for normal distibution noise
+    double dt;
+
+    getData(filename, timestamps, gt_pos);
+    error = errorGenerator(0, stddev, gt_pos.size());
+
+    MatrixXd A(num_states, num_states);
+    MatrixXd B = MatrixXd::Zero(num_states, 1);
+    MatrixXd H(num_measurements, num_states);
+    MatrixXd Q(num_states, num_states);
+    MatrixXd R(num_measurements, num_measurements);
+    MatrixXd P(num_states, num_states);
+
+    VectorXd x(num_states);
+    VectorXd u = VectorXd::Zero(1);
+    VectorXd y(num_measurements);
+
+    H << 1, 0;
+    Q << 0.1, 0, 0, 0.1;
+    R << pow(stddev, 2);
+    P << 0, 0, 0, 0;
+    x << gt_pos[0], 0;
+
+    // same log as one list of steps for the parallel filter
+    vector<FilterStep> steps;
+    for(size_t i = 1; i < gt_pos.size(); i++) {
+        dt = (timestamps[i] - timestamps[i-1])/1000;
+        A << 1, dt, 0, 1;
+        y << gt_pos[i] + error[i];
+        steps.push_back({A, B, u, y, R, MatrixXd()});
+    }
+
+    KalmanFilter KF_seq(num_states, num_measurements);
+    KF_seq.setObervationMatrix(H);
+    KF_seq.setInitState(x, P);
+    KF_seq.setNoiseCovariance(Q);
+
+    ParallelKalmanFilter KF_par(num_states, num_measurements, 4);
+    KF_par.setObervationMatrix(H);
+    KF_par.setInitState(x, P);
+    KF_par.setNoiseCovariance(Q);
+    KF_par.filter(steps);
+    KF_par.smooth(steps);
+
+    double max_diff = 0;
+    double mse_e_gt = 0;
+    double mse_s_gt = 0;
+    for(size_t k = 0; k < steps.size(); k++) {
+        KF_seq.predict(steps[k].A, B, u);
+        KF_seq.update(steps[k].y, R);
+
+        x = KF_seq.getStateEstimate();
+        max_diff = max(max_diff, (x - KF_par.getStateEstimates()[k]).cwiseAbs().maxCoeff());
+        mse_e_gt += pow(gt_pos[k+1] - KF_par.getStateEstimates()[k][0], 2);
+        mse_s_gt += pow(gt_pos[k+1] - KF_par.getSmoothedStates()[k][0], 2);
+    }
+
+    mse_e_gt /= steps.size();
+    mse_s_gt /= steps.size();
+
+    cout << "Parallel-in-time KF on sensor data:\n";
+    cout << "Max difference to sequential KF estimate is: " << max_diff << "\n";
+    cout << "MSE between estimated and gt position is: " << mse_e_gt << "\n";
+    cout << "MSE between smoothed and gt position is: " << mse_s_gt << "\n";
+}
+
+
+void task4() {
+    int num_states = 2;        // x_pos, x_vel
+    int num_measurements = 1;  // xm_pos
+    int num_tracks = 8;        // tracks of the same sensor with own noise
+
+    string filename = "../data/cam_data1.txt";
+
+    vector<double> timestamps;
+    vector<double> gt_pos;
+    vector<vector<double>> error(num_tracks);
+    double stddev = 1;        // standard deviation for normal distibution noise
+    double dt;
+
+    getData(filename, timestamps, gt_pos);
+    for(int t = 0; t < num_tracks; t++) {
+        error[t] = errorGenerator(0, stddev, gt_pos.size());
+    }
+
+    MatrixXd A(num_states, num_states);
+    MatrixXd B = MatrixXd::Zero(num_states, 1);
+    MatrixXd H(num_measurements, num_states);
+    MatrixXd Q(num_states, num_states);
+    MatrixXd R(num_measurements, num_measurements);
+    MatrixXd P(num_states, num_states);
+
+    VectorXd x(num_states);
+    VectorXd u = VectorXd::Zero(1);
+    VectorXd y(num_measurements);
+    vector<double> ys(num_tracks);
+
+    H << 1, 0;
+    Q << 0.1, 0, 0, 0.1;
+    R << pow(stddev, 2);
+    P << 0, 0, 0, 0;
+    x << gt_pos[0], 0;
+
+    SharedCovarianceGroup group(num_states, num_measurements);
+    group.setObervationMatrix(H);
+    group.setNoiseCovariance(Q);
+    group.setInitCovariance(P);
+
+    vector<KalmanFilter> filters(num_tracks, KalmanFilter(num_states, num_measurements));
+    for(int t = 0; t < num_tracks; t++) {
+        group.addTrack(x);
+        filters[t].setObervationMatrix(H);
+        filters[t].setInitState(x, P);
+        filters[t].setNoiseCovariance(Q);
+    }
+
+    double max_diff = 0;
+    double mse_e_gt = 0;
+    for(size_t i = 1; i < gt_pos.size(); i++) {
+        dt = (timestamps[i] - timestamps[i-1])/1000;
+        A << 1, dt, 0, 1;
+        for(int t = 0; t < num_tracks; t++) {
+            ys[t] = gt_pos[i] + error[t][i];
+            filters[t].predict(A, B, u);
+            y << ys[t];
+            filters[t].update(y, R);
+        }
+        group.step(A, ys, R);
+
+        for(int t = 0; t < num_tracks; t++) {
+            x = group.getStateEstimate(t);
+            max_diff = max(max_diff, (x - filters[t].getStateEstimate()).cwiseAbs().maxCoeff());
+            mse_e_gt += pow(gt_pos[i] - x[0], 2);
+        }
+    }
+
+    mse_e_gt /= (gt_pos.size() - 1) * num_tracks;
+
+    cout << "Shared covariance KF for " << num_tracks << " tracks of the same sensor:\n";
+    cout << "Max difference to separate KF estimates is: " << max_diff << "\n";
+    cout << "MSE between estimated and gt position is: " << mse_e_gt << "\n";
+}
+
+
+void task5() {
+    int num_models = 2;        // constant velocity, constant acceleration
+    int num_states = 3;        // x_pos, x_vel, x_acc
+    int num_measurements = 1;  // xm_pos
+
+    string filename = "../data/cam_data1.txt";
+
+    vector<double> timestamps;
+    vector<double> gt_pos;
+    vector<double> error;
+    double stddev = 1;        // standard deviation for normal distibution noise
+    double dt;
+
+    getData(filename, timestamps, gt_pos);
+    error = errorGenerator(0, stddev, gt_pos.size());
+
+    MatrixXd A_cv(num_states, num_states);
+    MatrixXd A_ca(num_states, num_states);
+    MatrixXd Q_cv(num_states, num_states);
+    MatrixXd Q_ca(num_states, num_states);
+    MatrixXd H(num_measurements, num_states);
+    MatrixXd R(num_measurements, num_measurements);
+    MatrixXd P(num_states, num_states);
+    MatrixXd T(num_models, num_models);
+
+    VectorXd x(num_states);
+    VectorXd mu(num_models);
+    VectorXd y(num_measurements);
+
+    double mse_e_gt = 0;
+
+    H << 1, 0, 0;
+    Q_cv << 0.1, 0, 0, 0, 0.1, 0, 0, 0, 0;   // acceleration unused by CV
+    Q_ca << 0.01, 0, 0, 0, 0.01, 0, 0, 0, 0.1;
+    R << pow(stddev, 2);
+    P << 0, 0, 0, 0, 0, 0, 0, 0, 0;
+    T << 0.95, 0.05, 0.05, 0.95;
+    x << gt_pos[0], 0, 0;
+    mu << 0.5, 0.5;
+
+    IMMFilter IMM(num_models, num_states, num_measurements);
+    IMM.setObervationMatrix(H);
+    IMM.setTransitionProbabilities(T);
+    IMM.setInitState(x, P, mu);
+
+    for(size_t i = 1; i < gt_pos.size(); i++) {
+        dt = (timestamps[i] - timestamps[i-1])/1000;
+        A_cv << 1, dt, 0, 0, 1, 0, 0, 0, 0;
+        A_ca << 1, dt, 0.5*pow(dt, 2), 0, 1, dt, 0, 0, 1;
+        IMM.setModel(0, A_cv, Q_cv);
+        IMM.setModel(1, A_ca, Q_ca);
+        IMM.predict();
+
+        y << gt_pos[i] + error[i];
+        IMM.update(y, R);
+
+        mse_e_gt += pow(gt_pos[i] - IMM.getStateEstimate()[0], 2);
+    }
+
+    mse_e_gt /= gt_pos.size() - 1;
+
+    cout << "IMM filter (CV + CA) to filter out noise from sensor data:\n";
+    cout << "MSE between estimated and gt position is: " << mse_e_gt << "\n";
+    cout << "Final model probabilities (CV, CA): " << IMM.getModelProbabilities().transpose() << "\n";
+}
+
+
+void task6() {
+    int num_states = 2;        // x_pos, x_vel
+    int num_measurements = 1;  // xm_pos
+    int capacity = 8;          // maximum number of live tracks
+    int birth_interval = 20;   // samples between track births
+
+    string filename = "../data/cam_data1.txt";
+
+    vector<double> timestamps;
+    vector<double> gt_pos;
+    vector<double> error;
+    double stddev = 1;        // standard deviation for normal distibution noise
+    double dt;
+
+    getData(filename, timestamps, gt_pos);
+    error = errorGenerator(0, stddev, gt_pos.size());
+
+    MatrixXd A(num_states, num_states);
+    MatrixXd B = MatrixXd::Zero(num_states, 1);
+    MatrixXd H(num_measurements, num_states);
+    MatrixXd Q(num_states, num_states);
+    MatrixXd R(num_measurements, num_measurements);
+    MatrixXd P(num_states, num_states);
+
+    VectorXd x(num_states);
+    VectorXd u = VectorXd::Zero(1);
+    VectorXd y(num_measurements);
+
+    H << 1, 0;
+    Q << 0.1, 0, 0, 0.1;
+    R << pow(stddev, 2);
+    P << 1, 0, 0, 1;
+
+    TrackPool pool(num_states, num_measurements, capacity);
+    pool.setObervationMatrix(H);
+    pool.setNoiseCovariance(Q);
+
+    // handles in birth order, the oldest track dies when the pool is full
+    vector<TrackHandle> alive(capacity);
+    int oldest = 0;
+    int born = 0;
+    int died = 0;
+    int stale_accepted = 0;
+    double mse_e_gt = 0;
+    int num_estimates = 0;
+
+    for(size_t i = 0; i < gt_pos.size(); i++) {
+        if(i > 0) {
+            dt = (timestamps[i] - timestamps[i-1])/1000;
+            A << 1, dt, 0, 1;
+            pool.predictAll(A, B, u);
+
+            y << gt_pos[i] + error[i];
+            for(int k = 0; k < pool.size(); k++) {
+                TrackHandle track = pool.handleAt(k);
+                pool.update(track, y, R);
+                mse_e_gt += pow(gt_pos[i] - pool.getStateEstimate(track)[0], 2);
+                num_estimates++;
+            }
+        }
+
+        if(i % birth_interval == 0) {
+            if(pool.size() == capacity) {
+                TrackHandle dead = alive[oldest];
+                pool.destroy(dead);
+                stale_accepted += pool.valid(dead) ? 1 : 0;
+                oldest = (oldest + 1) % capacity;
+                died++;
+            }
+            x << gt_pos[i] + error[i], 0;
+            alive[(oldest + pool.size()) % capacity] = pool.create(x, P);
+            born++;
+        }
+    }
+
+    mse_e_gt /= num_estimates;
+
+    cout << "Pooled tracks with churn (capacity " << capacity << "):\n";
+    cout << "Tracks born: " << born << ", died: " << died
+         << ", stale handles accepted: " << stale_accepted << "\n";
+    cout << "MSE between estimated and gt position is: " << mse_e_gt << "\n";
+}
+
+
+void task7() {
+    int num_states = 2;        // x_pos, x_vel
+    int num_measurements = 2;  // xm_pos in m and in cm
+
+    string filename = "../data/cam_data1.txt";
+
+    vector<double> timestamps;
+    vector<double> gt_pos;
+    vector<double> error;
+    double stddev = 1;        // standard deviation for normal distibution noise
+    double dt;
+
+    getData(filename, timestamps, gt_pos);
+    error = errorGenerator(0, stddev, gt_pos.size());
+
+    MatrixXd A(num_states, num_states);
+    MatrixXd B = MatrixXd::Zero(num_states, 1);
+    MatrixXd H(num_measurements, num_states);
+    MatrixXd Q(num_states, num_states);
+    MatrixXd R(num_measurements, num_measurements);
+    MatrixXd P(num_states, num_states);
+
+    VectorXd x(num_states);
+    VectorXd u = VectorXd::Zero(1);
+    VectorXd y(num_measurements);
+
+    // every row observes one scaled state, fromMatrix tags it DiagonalScaled
+    H << 1, 0, 100, 0;
+    Q << 0.1, 0, 0, 0.1;
+    R << pow(stddev, 2), 0, 0, pow(100 * stddev, 2);
+    P << 0, 0, 0, 0;
+    x << gt_pos[0], 0;
+
+    ObservationModel H_idx = ObservationModel::fromMatrix(H);
+
+    KalmanFilter KF_dense(num_states, num_measurements);
+    KF_dense.setObervationMatrix(ObservationModel::dense(H));
+    KF_dense.setInitState(x, P);
+    KF_dense.setNoiseCovariance(Q);
+
+    KalmanFilter KF_idx(num_states, num_measurements);
+    KF_idx.setObervationMatrix(H_idx);
+    KF_idx.setInitState(x, P);
+    KF_idx.setNoiseCovariance(Q);
+
+    double max_diff = 0;
+    double mse_e_gt = 0;
+    for(size_t i = 1; i < gt_pos.size(); i++) {
+        dt = (timestamps[i] - timestamps[i-1])/1000;
+        A << 1, dt, 0, 1;
+        y << gt_pos[i] + error[i], 100 * (gt_pos[i] + error[i]);
+
+        KF_dense.predict(A, B, u);
+        KF_dense.update(y, R);
+        KF_idx.predict(A, B, u);
+        KF_idx.update(y, R);
+
+        x = KF_idx.getStateEstimate();
+        max_diff = max(max_diff, (x - KF_dense.getStateEstimate()).cwiseAbs().maxCoeff());
+        max_diff = max(max_diff, (KF_idx.getCovarianceEstimate() -
+            KF_dense.getCovarianceEstimate()).cwiseAbs().maxCoeff());
+        mse_e_gt += pow(gt_pos[i] - x[0], 2);
+    }
+
+    mse_e_gt /= gt_pos.size() - 1;
+
+    cout << "Indexed update with a diagonal scaled H:\n";
+    cout << "Structure picked by fromMatrix: "
+         << (H_idx.type() == ObservationModel::Type::DiagonalScaled ? "diagonal scaled" : "other")
+         << "\n";
+    cout << "Max difference to dense update estimate is: " << max_diff << "\n";
+    cout << "MSE between estimated and gt position is: " << mse_e_gt << "\n";
+}
+
+
+int main(int argc, char** argv) {
+    // pick kernel ISA level (--isa=<level> or KF_ISA, else CPUID)
+    try {
+        selectIsaFromArgs(argc, argv);
+        const char* isa = kernels().name;
+        cout << "Kernel ISA level: " << isa << "\n";
+    }
+    catch(const exception& e) {
+        cerr << e.what() << "\n";
+        cerr << "usage: KalmanFilter [--isa=<baseline|sse4.2|avx2|avx512>]\n";
+        return 1;
+    }
+
     // Kalman filter with 1 sensor
     task1();
     // Kalman filter with 2 intependent sensors
     task2();
+    // Parallel-in-time Kalman filter and smoother with 1 sensor
+    task3();
+    // Kalman filter for many tracks sharing one covariance
+    task4();
+    // IMM filter bank with constant velocity and acceleration models
+    task5();
+    // Pooled tracks with births and deaths
+    task6();
+    // Indexed update against the dense one
+    task7();
 
     return 0;
 }
\ No newline at end of file
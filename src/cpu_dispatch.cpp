@@ -0,0 +1,387 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @file cpu_dispatch.cpp
+ * @author Rishabh Mukund (rishabh.m96@gmail.com)
+ * @brief Runtime selection of the ISA level used by the filter kernels
+ * @version 1.0
+ * @date 18/10/2026
+ *
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+*/
+
+#include "cpu_dispatch.hpp"
+
+#include<atomic>
+#include<cstdlib>
+#include<cstring>
+#include<mutex>
+#include<stdexcept>
+#include<string>
+
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief check if CPU supports an ISA level, using CPUID through the
+ *        compiler builtins (which also check the OS saves the AVX state)
+*/
+bool cpuSupports(IsaLevel level) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    switch(level) {
+        case IsaLevel::Baseline:
+            return true;
+        case IsaLevel::SSE42:
+            return __builtin_cpu_supports("sse4.2");
+        case IsaLevel::AVX2:
+            return __builtin_cpu_supports("avx2") &&
+                   __builtin_cpu_supports("fma");
+        case IsaLevel::AVX512:
+            return __builtin_cpu_supports("avx512f") &&
+                   __builtin_cpu_supports("avx512dq") &&
+                   __builtin_cpu_supports("avx512vl") &&
+                   __builtin_cpu_supports("avx2") &&
+                   __builtin_cpu_supports("fma");
+    }
+    return false;
+#else
+    return level == IsaLevel::Baseline;
+#endif
+}
+
+
+/**
+ * @brief get kernel table compiled for level, nullptr if not built
+*/
+const KernelTable* tableFor(IsaLevel level) {
+    switch(level) {
+        case IsaLevel::Baseline:
+            return &kBaselineKernels;
+        case IsaLevel::SSE42:
+#ifdef KF_HAVE_SSE42
+            return &kSse42Kernels;
+#else
+            return nullptr;
+#endif
+        case IsaLevel::AVX2:
+#ifdef KF_HAVE_AVX2
+            return &kAvx2Kernels;
+#else
+            return nullptr;
+#endif
+        case IsaLevel::AVX512:
+#ifdef KF_HAVE_AVX512
+            return &kAvx512Kernels;
+#else
+            return nullptr;
+#endif
+    }
+    return nullptr;
+}
+
+
+/*
+ * For small state vectors the scalar kernels are dominated by loop
+ * overhead and the 256/512 bit builds lose to the 128 bit one (about
+ * 1.2x at n = 2, 1.4x at n = 6 in KalmanFilterBench), from n = 8 on the
+ * wider registers pay off. When the level comes from CPUID the AVX levels
+ * therefore run their scalar kernels through these wrappers, which hand
+ * small filters to the SSE4.2 build. Batched kernels always use the
+ * detected level. A level forced by --isa, KF_ISA or setIsaLevel() runs
+ * its own kernels for every size.
+*/
+constexpr int kWideScalarMinStates = 8;
+
+#ifdef KF_HAVE_SSE42
+template<const KernelTable& Wide>
+void predictSized(int n, const double* A, const double* B, double u,
+    const double* Q, const double* xe, const double* Pe,
+    double* xp, double* Pp, double* work) {
+    const KernelTable& k = n < kWideScalarMinStates ? kSse42Kernels : Wide;
+    k.predict(n, A, B, u, Q, xe, Pe, xp, Pp, work);
+}
+
+
+template<const KernelTable& Wide>
+int updateSized(int n, int m, const double* H, const double* R,
+    const double* y, const double* xp, const double* Pp,
+    double* xe, double* Pe, double* K, double* work) {
+    const KernelTable& k = n < kWideScalarMinStates ? kSse42Kernels : Wide;
+    return k.update(n, m, H, R, y, xp, Pp, xe, Pe, K, work);
+}
+
+
+template<const KernelTable& Wide>
+int updateIndexedSized(int n, int m, const int* index, const double* scale,
+    const double* R, const double* y, const double* xp, const double* Pp,
+    double* xe, double* Pe, double* K, double* work) {
+    const KernelTable& k = n < kWideScalarMinStates ? kSse42Kernels : Wide;
+    return k.updateIndexed(n, m, index, scale, R, y, xp, Pp, xe, Pe, K, work);
+}
+
+
+/**
+ * @brief copy of Wide with the scalar kernels picked by state count,
+ *        built on first use since Wide lives in another translation unit
+*/
+template<const KernelTable& Wide>
+const KernelTable* sizedTable() {
+    static const string name = string(Wide.name) + " (scalar: " +
+        kSse42Kernels.name + " for n<" + to_string(kWideScalarMinStates) + ")";
+    static const KernelTable table = {
+        name.c_str(),
+        predictSized<Wide>,
+        updateSized<Wide>,
+        updateIndexedSized<Wide>,
+        Wide.predictBatch,
+        Wide.updateBatch,
+        Wide.propagateShared,
+        Wide.mixBatch,
+    };
+    return &table;
+}
+#endif
+
+
+/**
+ * @brief get kernels used for a level detected by CPUID, nullptr if not
+ *        built
+*/
+const KernelTable* detectedTableFor(IsaLevel level) {
+    switch(level) {
+        case IsaLevel::Baseline:
+        case IsaLevel::SSE42:
+            return tableFor(level);
+        case IsaLevel::AVX2:
+#if defined(KF_HAVE_AVX2) && defined(KF_HAVE_SSE42)
+            return sizedTable<kAvx2Kernels>();
+#else
+            return nullptr;
+#endif
+        case IsaLevel::AVX512:
+#if defined(KF_HAVE_AVX512) && defined(KF_HAVE_SSE42)
+            return sizedTable<kAvx512Kernels>();
+#else
+            return nullptr;
+#endif
+    }
+    return nullptr;
+}
+
+
+atomic<int> active_level(-1);
+atomic<const KernelTable*> active_table(nullptr);
+once_flag default_once;   // set once a startup level is chosen or forced
+
+
+/**
+ * @brief make level the active one, detected picks the kernels by state
+ *        count at the AVX levels
+*/
+void activate(IsaLevel level, bool detected) {
+    if(!isaSupported(level)) {
+        throw runtime_error(string("ISA level not supported on this machine: ") +
+            isaName(level));
+    }
+    active_table.store(detected ? detectedTableFor(level) : tableFor(level),
+        memory_order_release);
+    active_level.store(static_cast<int>(level), memory_order_release);
+}
+
+
+/**
+ * @brief pick the startup level once, from KF_ISA or CPUID
+*/
+void initDefault() {
+    call_once(default_once, [] {
+        const char* env = getenv("KF_ISA");
+        if(env != nullptr && *env != '\0') {
+            activate(parseIsaLevel(env), false);
+        }
+        else {
+            activate(detectIsaLevel(), true);
+        }
+    });
+}
+
+}  // namespace
+
+
+/**
+ * @brief get name of ISA level (baseline, sse4.2, avx2, avx512)
+ * 
+ * @param level (IsaLevel) - ISA level
+ * 
+ * @return (const char*) - name of ISA level
+*/
+const char* isaName(IsaLevel level) {
+    switch(level) {
+        case IsaLevel::Baseline:
+            return "baseline";
+        case IsaLevel::SSE42:
+            return "sse4.2";
+        case IsaLevel::AVX2:
+            return "avx2";
+        case IsaLevel::AVX512:
+            return "avx512";
+    }
+    return "unknown";
+}
+
+
+/**
+ * @brief parse ISA level from its name, as accepted by --isa and KF_ISA
+ * 
+ * @param name (string) - name of ISA level
+ * 
+ * @return (IsaLevel) - ISA level
+*/
+IsaLevel parseIsaLevel(const string& name) {
+    if(name == "baseline" || name == "sse2") {
+        return IsaLevel::Baseline;
+    }
+    if(name == "sse4.2" || name == "sse42") {
+        return IsaLevel::SSE42;
+    }
+    if(name == "avx2") {
+        return IsaLevel::AVX2;
+    }
+    if(name == "avx512") {
+        return IsaLevel::AVX512;
+    }
+    throw runtime_error("Unknown ISA level: " + name);
+}
+
+
+/**
+ * @brief get highest ISA level supported by both the CPU (via CPUID)
+ *        and this binary
+ * 
+ * @return (IsaLevel) - detected ISA level
+*/
+IsaLevel detectIsaLevel() {
+    const IsaLevel levels[] = {IsaLevel::AVX512, IsaLevel::AVX2, IsaLevel::SSE42};
+    for(IsaLevel level : levels) {
+        if(isaSupported(level)) {
+            return level;
+        }
+    }
+    return IsaLevel::Baseline;
+}
+
+
+/**
+ * @brief check if ISA level can run on this CPU and was compiled in
+ * 
+ * @param level (IsaLevel) - ISA level
+ * 
+ * @return (bool) - true if kernels for level can be used
+*/
+bool isaSupported(IsaLevel level) {
+    return tableFor(level) != nullptr && cpuSupports(level);
+}
+
+
+/**
+ * @brief force the ISA level used by the filter kernels
+ * @details An explicit level takes precedence over KF_ISA, which is then
+ *          never read (so a bad KF_ISA value does not get in the way)
+ * 
+ * @param level (IsaLevel) - ISA level, must be supported
+*/
+void setIsaLevel(IsaLevel level) {
+    activate(level, false);
+    call_once(default_once, [] {});
+}
+
+
+/**
+ * @brief get the ISA level currently in use
+ * 
+ * @return (IsaLevel) - active ISA level
+*/
+IsaLevel activeIsaLevel() {
+    initDefault();
+    return static_cast<IsaLevel>(active_level.load(memory_order_acquire));
+}
+
+
+/**
+ * @brief apply an --isa=<level> (or --isa <level>) command line override
+ * 
+ * @param argc (int&) - reference of argument count
+ * @param argv (char**) - argument vector
+*/
+void selectIsaFromArgs(int& argc, char** argv) {
+    int out = 1;
+    for(int i = 1; i < argc; i++) {
+        if(strncmp(argv[i], "--isa=", 6) == 0) {
+            setIsaLevel(parseIsaLevel(argv[i] + 6));
+        }
+        else if(strcmp(argv[i], "--isa") == 0) {
+            if(i + 1 >= argc) {
+                throw runtime_error("Missing value for --isa.");
+            }
+            setIsaLevel(parseIsaLevel(argv[++i]));
+        }
+        else {
+            argv[out++] = argv[i];
+        }
+    }
+    argc = out;
+    argv[argc] = nullptr;
+}
+
+
+/**
+ * @brief get kernel table for the active ISA level
+ * 
+ * @return (const KernelTable&) - filter kernels
+*/
+const KernelTable& kernels() {
+    const KernelTable* table = active_table.load(memory_order_acquire);
+    if(table == nullptr) {
+        initDefault();
+        table = active_table.load(memory_order_acquire);
+    }
+    return *table;
+}
+
+
+/**
+ * @brief get kernel table for a given ISA level
+ * 
+ * @param level (IsaLevel) - ISA level, must be supported
+ * 
+ * @return (const KernelTable&) - filter kernels
+*/
+const KernelTable& kernels(IsaLevel level) {
+    if(!isaSupported(level)) {
+        throw runtime_error(string("ISA level not supported on this machine: ") +
+            isaName(level));
+    }
+    return *tableFor(level);
+}
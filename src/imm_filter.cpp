@@ -0,0 +1,374 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @file imm_filter.cpp
+ * @author Rishabh Mukund (rishabh.m96@gmail.com)
+ * @brief Interacting Multiple Model (IMM) filter bank
+ * @version 1.0
+ * @date 18/10/2026
+ *
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+*/
+
+#include "imm_filter.hpp"
+#include "cpu_dispatch.hpp"
+
+#include<algorithm>
+#include<cmath>
+#include<stdexcept>
+
+
+using namespace Eigen;
+using namespace std;
+
+/**
+ * @brief Constructor for IMMFilter class
+ * 
+ * @param num_models (int) - Number of models
+ * @param num_states (int) - Number of state parameters
+ * @param num_measurements (int) - Number of independent measurements
+*/
+IMMFilter::IMMFilter(int num_models, int num_states, int num_measurements)
+    : num_models_(num_models),
+      num_lanes_(num_models <= 2 ? num_models : (num_models <= 4 ? 4 :
+                 (num_models <= 8 ? 8 : num_models))),
+      num_states_(num_states),
+      num_measurements_(num_measurements),
+      A_(num_states * num_states * num_lanes_, 0.0),
+      Q_(num_states * num_states * num_lanes_, 0.0),
+      x_(num_states * num_lanes_, 0.0),
+      P_(num_states * num_states * num_lanes_, 0.0),
+      x0_(num_states * num_lanes_, 0.0),
+      P0_(num_states * num_states * num_lanes_, 0.0),
+      H_(num_measurements * num_states, 0.0),
+      W_(num_models * num_lanes_, 0.0),
+      T_(MatrixXd::Identity(num_models, num_models)),
+      mu_(VectorXd::Constant(num_models, 1.0 / num_models)),
+      c_(num_models),
+      y_(num_lanes_),
+      innov_(num_lanes_),
+      s_(num_lanes_),
+      q_(num_lanes_),
+      det_(num_lanes_),
+      work_(max((num_states + num_states * num_states) * num_lanes_,
+                (2 * num_states + 2) * num_lanes_)),
+      xc_(VectorXd::Zero(num_states)),
+      Pc_(MatrixXd::Zero(num_states, num_states)),
+      state_valid_(false),
+      covariance_valid_(false)
+    {
+        if(num_models < 1 || num_states < 1 || num_measurements < 1) {
+            throw runtime_error("Invalid dimensions for IMM filter.");
+        }
+    }
+
+
+/**
+ * @brief set state transition (A) and noise covariance (Q) of a model
+ * 
+ * @param k (int) - index of the model
+ * @param A (MatrixXd) - State transition matrix
+ * @param Q (MatrixXd) - Process Noise Covariance Matrix
+*/
+void IMMFilter::setModel(int k, const MatrixXd& A, const MatrixXd& Q) {
+    if(k < 0 || k >= num_models_) {
+        throw runtime_error("Invalid model index.");
+    }
+    if(A.rows() != num_states_ || A.cols() != num_states_ ||
+       Q.rows() != num_states_ || Q.cols() != num_states_) {
+        throw runtime_error("Invalid dimensions for state matrices.");
+    }
+
+    const int n = num_states_;
+    const int L = num_lanes_;
+    for(int c = 0; c < n; c++) {
+        for(int r = 0; r < n; r++) {
+            A_[(r + c*n) * L + k] = A(r, c);
+            Q_[(r + c*n) * L + k] = Q(r, c);
+        }
+    }
+}
+
+
+/**
+ * @brief set obervation matrix (H) shared by all models
+ * 
+ * @param H (MatrixXd) - Obervation matrix 
+*/
+void IMMFilter::setObervationMatrix(const MatrixXd& H) {
+    if(H.rows() != num_measurements_ || H.cols() != num_states_) {
+        throw runtime_error("Invalid dimension for obeservation matrix.");
+    }
+    for(int a = 0; a < num_measurements_; a++) {
+        for(int k = 0; k < num_states_; k++) {
+            H_[a * num_states_ + k] = H(a, k);
+        }
+    }
+}
+
+
+/**
+ * @brief set model transition probabilities
+ * 
+ * @param T (MatrixXd) - (K x K) matrix, T(i, j) is the probability to
+ *                       switch from model i to model j, rows sum to 1
+*/
+void IMMFilter::setTransitionProbabilities(const MatrixXd& T) {
+    if(T.rows() != num_models_ || T.cols() != num_models_) {
+        throw runtime_error("Invalid dimension for model transition matrix.");
+    }
+    if(T.minCoeff() < 0) {
+        throw runtime_error("Model transition probabilities must not be negative.");
+    }
+    T_ = T;
+}
+
+
+/**
+ * @brief set initial state of every model and the model probabilities
+ * 
+ * @param xi (VectorXd) - Initial state vector
+ * @param Pi (MatrixXd) - Initial Process Covariance Matrix
+ * @param mu (VectorXd) - Initial model probabilities
+*/
+void IMMFilter::setInitState(const VectorXd& xi, const MatrixXd& Pi, const VectorXd& mu) {
+    if(xi.size() != num_states_ || Pi.rows() != num_states_ ||
+       Pi.cols() != num_states_ || mu.size() != num_models_) {
+        throw runtime_error("Invalid dimensions for system state.");
+    }
+
+    const int n = num_states_;
+    const int K = num_models_;
+    const int L = num_lanes_;
+    for(int k = 0; k < K; k++) {
+        for(int i = 0; i < n; i++) {
+            x_[i*L + k] = xi(i);
+        }
+        for(int e = 0; e < n*n; e++) {
+            P_[e*L + k] = Pi(e % n, e / n);
+        }
+    }
+    mu_ = mu / mu.sum();
+    state_valid_ = false;
+    covariance_valid_ = false;
+}
+
+
+/**
+ * @brief mix the model estimates according to the model transition
+ *        probabilities, result is written back to x_ and P_
+*/
+void IMMFilter::mix() {
+    const int n = num_states_;
+    const int K = num_models_;
+    const int L = num_lanes_;
+
+    // c_j = sum_i T(i, j) mu_i,  W(i, j) = T(i, j) mu_i / c_j, lane-major
+    // with the padding lanes left at zero
+    for(int j = 0; j < K; j++) {
+        double c = 0;
+        for(int i = 0; i < K; i++) {
+            c += T_(i, j) * mu_(i);
+        }
+        c_(j) = c;
+        const double inv = c > 0 ? 1 / c : 0;
+        for(int i = 0; i < K; i++) {
+            W_[i*L + j] = inv > 0 ? T_(i, j) * mu_(i) * inv : (i == j ? 1 : 0);
+        }
+    }
+
+    kernels().mixBatch(n, K, L, W_.data(), x_.data(), P_.data(), x0_.data(),
+        P0_.data());
+    x_.swap(x0_);
+    P_.swap(P0_);
+}
+
+
+/**
+ * @brief combine the model state vectors into the output estimate
+*/
+void IMMFilter::combineState() const {
+    const int n = num_states_;
+    const int K = num_models_;
+    const int L = num_lanes_;
+
+    for(int i = 0; i < n; i++) {
+        double s = 0;
+        for(int k = 0; k < K; k++) {
+            s += mu_(k) * x_[i*L + k];
+        }
+        xc_(i) = s;
+    }
+    state_valid_ = true;
+}
+
+
+/**
+ * @brief combine the model covariances into the output estimate
+*/
+void IMMFilter::combineCovariance() const {
+    const int n = num_states_;
+    const int K = num_models_;
+    const int L = num_lanes_;
+
+    if(!state_valid_) {
+        combineState();
+    }
+    for(int c = 0; c < n; c++) {
+        for(int r = 0; r < n; r++) {
+            const int e = r + c*n;
+            double s = 0;
+            for(int k = 0; k < K; k++) {
+                const double dr = x_[r*L + k] - xc_(r);
+                const double dc = x_[c*L + k] - xc_(c);
+                s += mu_(k) * (P_[e*L + k] + dr * dc);
+            }
+            Pc_(r, c) = s;
+        }
+    }
+    covariance_valid_ = true;
+}
+
+
+/**
+ * @brief run mixing and the predict step of every model
+*/
+void IMMFilter::predict() {
+    mix();
+    kernels().predictBatch(num_states_, num_lanes_, A_.data(), Q_.data(),
+        x_.data(), P_.data(), work_.data());
+    mu_ = c_;
+    state_valid_ = false;
+    covariance_valid_ = false;
+}
+
+
+/**
+ * @brief run the update step of every model and update the model probabilities
+ * 
+ * @param y (VectorXd) - Measured state variables
+ * @param R (MatrixXd) - Observation noise covariance matrix (diagonal)
+*/
+void IMMFilter::update(const VectorXd& y, const MatrixXd& R) {
+    if(R.rows() != num_measurements_ || R.cols() != num_measurements_ ||
+       y.size() != num_measurements_) {
+        throw runtime_error("Invalid dimension for Observation noise covariance matrix.");
+    }
+    for(int a = 0; a < num_measurements_; a++) {
+        for(int b = 0; b < num_measurements_; b++) {
+            if(a != b && R(a, b) != 0) {
+                throw runtime_error("IMM filter needs a diagonal observation noise covariance matrix.");
+            }
+        }
+    }
+
+    const int K = num_models_;
+    fill(q_.begin(), q_.end(), 0.0);
+    fill(det_.begin(), det_.end(), 1.0);
+
+    // uncorrelated measurement components can be applied one at a time,
+    // the product of their likelihoods is the joint likelihood
+    for(int a = 0; a < num_measurements_; a++) {
+        fill(y_.begin(), y_.end(), y(a));
+        kernels().updateBatch(num_states_, num_lanes_, &H_[a * num_states_], R(a, a),
+            y_.data(), x_.data(), P_.data(), innov_.data(), s_.data(),
+            work_.data());
+        for(int k = 0; k < K; k++) {
+            q_[k] += innov_[k] * innov_[k] / s_[k];
+            det_[k] *= s_[k];
+        }
+    }
+
+    // likelihood_k = exp(-q_k / 2) / sqrt((2 pi)^m det_k), taken relative
+    // to the smallest q and det so no factor underflows and no log is needed
+    const double q_min = *min_element(q_.begin(), q_.begin() + K);
+    const double det_min = *min_element(det_.begin(), det_.begin() + K);
+    double total = 0;
+    for(int k = 0; k < K; k++) {
+        mu_(k) *= exp(-0.5 * (q_[k] - q_min)) * sqrt(det_min / det_[k]);
+        total += mu_(k);
+    }
+    if(total > 0) {
+        mu_ /= total;
+    }
+    else {
+        mu_.setConstant(1.0 / K);
+    }
+    state_valid_ = false;
+    covariance_valid_ = false;
+}
+
+
+/**
+ * @brief get combined Estimated state vector
+ * 
+ * @return (VectorXd) - Estimated state vector
+*/
+const VectorXd& IMMFilter::getStateEstimate() const {
+    if(!state_valid_) {
+        combineState();
+    }
+    return xc_;
+}
+
+
+/**
+ * @brief get combined Estimated Process Covariance Matrix
+ * 
+ * @return (MatrixXd) - Estimated Process Covariance Matrix
+*/
+const MatrixXd& IMMFilter::getCovarianceEstimate() const {
+    if(!covariance_valid_) {
+        combineCovariance();
+    }
+    return Pc_;
+}
+
+
+/**
+ * @brief get model probabilities
+ * 
+ * @return (VectorXd) - probability of each model
+*/
+const VectorXd& IMMFilter::getModelProbabilities() const {
+    return mu_;
+}
+
+
+/**
+ * @brief get state vector of one model
+ * 
+ * @param k (int) - index of the model
+ * 
+ * @return (VectorXd) - state vector of the model
+*/
+VectorXd IMMFilter::getModelState(int k) const {
+    if(k < 0 || k >= num_models_) {
+        throw runtime_error("Invalid model index.");
+    }
+    VectorXd x(num_states_);
+    for(int i = 0; i < num_states_; i++) {
+        x(i) = x_[i * num_lanes_ + k];
+    }
+    return x;
+}
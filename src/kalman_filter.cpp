@@ -4,8 +4,8 @@
  * @file kalman_filter.cpp
  * @author Rishabh Mukund (rishabh.m96@gmail.com)
  * @brief Kalman Filter class definitions
- * @version 2.3
- * @date 14/07/2023
+ * @version 2.6
+ * @date 18/10/2026
  * 
  * 
  * MIT License
@@ -31,8 +31,10 @@
 */
 
 #include "kalman_filter.hpp"
+#include "cpu_dispatch.hpp"
 
 #include<iostream>
+#include<algorithm>
 
 using namespace Eigen;
 using namespace std;
@@ -47,10 +49,17 @@ using namespace std;
 KalmanFilter::KalmanFilter(int num_states, int num_measurements) 
     : num_states_(num_states),
       num_measurements_(num_measurements),
-      H_(num_measurements, num_states),
-      Q_(num_states, num_states)
+      H_(ObservationModel::dense(MatrixXd::Zero(num_measurements, num_states))),
+      Q_(num_states, num_states),
+      Pp_(num_states, num_states),
+      Pe_(num_states, num_states),
+      K_(num_states, num_measurements),
+      xp_(num_states),
+      xe_(num_states),
+      work_(max(num_states * num_states,
+                2 * num_states * num_measurements +
+                2 * num_measurements * num_measurements + num_measurements))
     {
-        I_ = MatrixXd::Identity(num_states, num_states);
     }
 
 
@@ -60,7 +69,17 @@ KalmanFilter::KalmanFilter(int num_states, int num_measurements)
  * @param H (MatrixXd) - Obervation matrix 
 */   
 void KalmanFilter::setObervationMatrix(const MatrixXd& H) {
-    if(H.rows() != num_measurements_ || H.cols() != num_states_) {
+    setObervationMatrix(ObservationModel::fromMatrix(H));
+}
+
+
+/**
+ * @brief set typed obervation model (H) of system
+ * 
+ * @param H (ObservationModel) - Obervation model
+*/
+void KalmanFilter::setObervationMatrix(const ObservationModel& H) {
+    if(H.matrix().rows() != num_measurements_ || H.matrix().cols() != num_states_) {
         throw runtime_error("Invalid dimension for obeservation matrix.");
     }
     H_ = H;
@@ -109,8 +128,8 @@ void KalmanFilter::predict(const MatrixXd& A, const MatrixXd& B, const VectorXd&
         throw runtime_error("Invalid dimensions for state matrices.");
        }
     
-    xp_ = (A * xe_) + (B * u);
-    Pp_ = (A * Pe_ * A.transpose()) + Q_; 
+    kernels().predict(num_states_, A.data(), B.data(), u(0), Q_.data(),
+        xe_.data(), Pe_.data(), xp_.data(), Pp_.data(), work_.data());
 }
 
 
@@ -125,9 +144,10 @@ void KalmanFilter::update(const VectorXd& y, const MatrixXd& R) {
        y.size() != num_measurements_) {
         throw runtime_error("Invalid dimension for Observation noise covariance matrix.");
        }
-    K_ = Pp_ * H_.transpose() * ((H_ * Pp_ * H_.transpose()) + R).inverse();
-    xe_ = xp_ + K_ * (y - (H_ * xp_));
-    Pe_ = (I_ - (K_ * H_)) * Pp_;
+    if(H_.update(kernels(), R.data(), y.data(), xp_.data(), Pp_.data(),
+           xe_.data(), Pe_.data(), K_.data(), work_.data()) != 0) {
+        throw runtime_error("Singular innovation covariance in update step.");
+    }
 }
 
 
@@ -141,6 +161,16 @@ VectorXd KalmanFilter::getStateEstimate() const {
 }
 
 
+/**
+ * @brief get Estimated covariance matrix
+ * 
+ * @return (MatrixXd) - Estimated covariance matrix
+*/
+MatrixXd KalmanFilter::getCovarianceEstimate() const {
+    return Pe_;
+}
+
+
 /**
  * @brief get Predicited state vector
  * 
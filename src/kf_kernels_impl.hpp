@@ -0,0 +1,890 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @file kf_kernels_impl.hpp
+ * @author Rishabh Mukund (rishabh.m96@gmail.com)
+ * @brief Kernel bodies, included once per ISA level
+ * @version 1.0
+ * @date 18/10/2026
+ *
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+*/
+
+/*
+ * No include guard on purpose. The including file defines
+ *   KF_KERNEL_TABLE - name of the KernelTable object to define
+ *   KF_KERNEL_NAME  - ISA level string reported by the table
+ * and is compiled with the matching -m flags. Nothing here may pull in
+ * inline code from other headers, otherwise the linker could pick an AVX
+ * copy of it for the baseline path.
+*/
+
+#include "kf_kernels.hpp"
+
+#if !defined(KF_KERNEL_TABLE) || !defined(KF_KERNEL_NAME)
+#error "KF_KERNEL_TABLE and KF_KERNEL_NAME must be defined"
+#endif
+
+#define KF_RESTRICT __restrict__
+
+namespace {
+
+void predict(int n, const double* KF_RESTRICT A, const double* KF_RESTRICT B,
+    double u, const double* KF_RESTRICT Q, const double* KF_RESTRICT xe,
+    const double* KF_RESTRICT Pe, double* KF_RESTRICT xp,
+    double* KF_RESTRICT Pp, double* KF_RESTRICT work) {
+    // xp = A * xe + B * u
+    for(int i = 0; i < n; i++) {
+        xp[i] = B[i] * u;
+    }
+    for(int j = 0; j < n; j++) {
+        const double xj = xe[j];
+        for(int i = 0; i < n; i++) {
+            xp[i] += A[i + j*n] * xj;
+        }
+    }
+
+    // work = A * Pe
+    double* KF_RESTRICT AP = work;
+    for(int c = 0; c < n; c++) {
+        for(int r = 0; r < n; r++) {
+            AP[r + c*n] = 0;
+        }
+        for(int k = 0; k < n; k++) {
+            const double p = Pe[k + c*n];
+            for(int r = 0; r < n; r++) {
+                AP[r + c*n] += A[r + k*n] * p;
+            }
+        }
+    }
+
+    // Pp = work * A' + Q
+    for(int c = 0; c < n; c++) {
+        for(int r = 0; r < n; r++) {
+            Pp[r + c*n] = Q[r + c*n];
+        }
+        for(int k = 0; k < n; k++) {
+            const double a = A[c + k*n];
+            for(int r = 0; r < n; r++) {
+                Pp[r + c*n] += AP[r + k*n] * a;
+            }
+        }
+    }
+}
+
+
+/**
+ * @brief Invert the (m x m) matrix S in place of Si by Gauss-Jordan
+ *        elimination with partial pivoting. S is destroyed.
+ *
+ * @return (int) - 0 on success, 1 if S is singular
+*/
+int invert(int m, double* KF_RESTRICT S, double* KF_RESTRICT Si) {
+    if(m == 1) {
+        if(S[0] == 0) {
+            return 1;
+        }
+        Si[0] = 1 / S[0];
+        return 0;
+    }
+
+    for(int c = 0; c < m; c++) {
+        for(int r = 0; r < m; r++) {
+            Si[r + c*m] = (r == c) ? 1 : 0;
+        }
+    }
+
+    for(int c = 0; c < m; c++) {
+        int pivot = c;
+        double best = S[c + c*m] < 0 ? -S[c + c*m] : S[c + c*m];
+        for(int r = c + 1; r < m; r++) {
+            const double v = S[r + c*m] < 0 ? -S[r + c*m] : S[r + c*m];
+            if(v > best) {
+                best = v;
+                pivot = r;
+            }
+        }
+        if(best == 0) {
+            return 1;
+        }
+
+        if(pivot != c) {
+            for(int k = 0; k < m; k++) {
+                double t = S[c + k*m];
+                S[c + k*m] = S[pivot + k*m];
+                S[pivot + k*m] = t;
+                t = Si[c + k*m];
+                Si[c + k*m] = Si[pivot + k*m];
+                Si[pivot + k*m] = t;
+            }
+        }
+
+        const double inv = 1 / S[c + c*m];
+        for(int k = 0; k < m; k++) {
+            S[c + k*m] *= inv;
+            Si[c + k*m] *= inv;
+        }
+
+        for(int r = 0; r < m; r++) {
+            if(r == c) {
+                continue;
+            }
+            const double f = S[r + c*m];
+            for(int k = 0; k < m; k++) {
+                S[r + k*m] -= f * S[c + k*m];
+                Si[r + k*m] -= f * Si[c + k*m];
+            }
+        }
+    }
+    return 0;
+}
+
+
+int update(int n, int m, const double* KF_RESTRICT H,
+    const double* KF_RESTRICT R, const double* KF_RESTRICT y,
+    const double* KF_RESTRICT xp, const double* KF_RESTRICT Pp,
+    double* KF_RESTRICT xe, double* KF_RESTRICT Pe, double* KF_RESTRICT K,
+    double* KF_RESTRICT work) {
+    double* KF_RESTRICT PHt = work;           // n x m
+    double* KF_RESTRICT HP = PHt + n*m;       // m x n
+    double* KF_RESTRICT S = HP + m*n;         // m x m
+    double* KF_RESTRICT Si = S + m*m;         // m x m
+    double* KF_RESTRICT v = Si + m*m;         // m
+
+    // PHt = Pp * H'
+    for(int c = 0; c < m; c++) {
+        for(int r = 0; r < n; r++) {
+            PHt[r + c*n] = 0;
+        }
+        for(int k = 0; k < n; k++) {
+            const double h = H[c + k*m];
+            for(int r = 0; r < n; r++) {
+                PHt[r + c*n] += Pp[r + k*n] * h;
+            }
+        }
+    }
+
+    // S = H * PHt + R
+    for(int b = 0; b < m; b++) {
+        for(int a = 0; a < m; a++) {
+            double s = R[a + b*m];
+            for(int k = 0; k < n; k++) {
+                s += H[a + k*m] * PHt[k + b*n];
+            }
+            S[a + b*m] = s;
+        }
+    }
+
+    if(invert(m, S, Si) != 0) {
+        return 1;
+    }
+
+    // K = PHt * S^-1
+    for(int c = 0; c < m; c++) {
+        for(int r = 0; r < n; r++) {
+            K[r + c*n] = 0;
+        }
+        for(int k = 0; k < m; k++) {
+            const double s = Si[k + c*m];
+            for(int r = 0; r < n; r++) {
+                K[r + c*n] += PHt[r + k*n] * s;
+            }
+        }
+    }
+
+    // v = y - H * xp
+    for(int a = 0; a < m; a++) {
+        double hx = 0;
+        for(int k = 0; k < n; k++) {
+            hx += H[a + k*m] * xp[k];
+        }
+        v[a] = y[a] - hx;
+    }
+
+    // xe = xp + K * v
+    for(int r = 0; r < n; r++) {
+        xe[r] = xp[r];
+    }
+    for(int a = 0; a < m; a++) {
+        for(int r = 0; r < n; r++) {
+            xe[r] += K[r + a*n] * v[a];
+        }
+    }
+
+    // HP = H * Pp
+    for(int c = 0; c < n; c++) {
+        for(int a = 0; a < m; a++) {
+            double s = 0;
+            for(int k = 0; k < n; k++) {
+                s += H[a + k*m] * Pp[k + c*n];
+            }
+            HP[a + c*m] = s;
+        }
+    }
+
+    // Pe = Pp - K * HP
+    for(int c = 0; c < n; c++) {
+        for(int r = 0; r < n; r++) {
+            Pe[r + c*n] = Pp[r + c*n];
+        }
+        for(int a = 0; a < m; a++) {
+            const double hp = HP[a + c*m];
+            for(int r = 0; r < n; r++) {
+                Pe[r + c*n] -= K[r + a*n] * hp;
+            }
+        }
+    }
+    return 0;
+}
+
+
+int updateIndexed(int n, int m, const int* KF_RESTRICT index,
+    const double* KF_RESTRICT scale, const double* KF_RESTRICT R,
+    const double* KF_RESTRICT y, const double* KF_RESTRICT xp,
+    const double* KF_RESTRICT Pp, double* KF_RESTRICT xe,
+    double* KF_RESTRICT Pe, double* KF_RESTRICT K,
+    double* KF_RESTRICT work) {
+    double* KF_RESTRICT PHt = work;           // n x m
+    double* KF_RESTRICT HP = PHt + n*m;       // m x n
+    double* KF_RESTRICT S = HP + m*n;         // m x m
+    double* KF_RESTRICT Si = S + m*m;         // m x m
+    double* KF_RESTRICT v = Si + m*m;         // m
+
+    // PHt = columns index of Pp, scaled
+    for(int a = 0; a < m; a++) {
+        const double* KF_RESTRICT col = Pp + index[a]*n;
+        const double s = scale != nullptr ? scale[a] : 1;
+        for(int r = 0; r < n; r++) {
+            PHt[r + a*n] = col[r] * s;
+        }
+    }
+
+    // S = rows index of PHt, scaled, + R
+    for(int b = 0; b < m; b++) {
+        for(int a = 0; a < m; a++) {
+            const double s = scale != nullptr ? scale[a] : 1;
+            S[a + b*m] = s * PHt[index[a] + b*n] + R[a + b*m];
+        }
+    }
+
+    if(invert(m, S, Si) != 0) {
+        return 1;
+    }
+
+    // K = PHt * S^-1
+    for(int c = 0; c < m; c++) {
+        for(int r = 0; r < n; r++) {
+            K[r + c*n] = 0;
+        }
+        for(int k = 0; k < m; k++) {
+            const double s = Si[k + c*m];
+            for(int r = 0; r < n; r++) {
+                K[r + c*n] += PHt[r + k*n] * s;
+            }
+        }
+    }
+
+    // v = y - H * xp
+    for(int a = 0; a < m; a++) {
+        const double s = scale != nullptr ? scale[a] : 1;
+        v[a] = y[a] - s * xp[index[a]];
+    }
+
+    // xe = xp + K * v
+    for(int r = 0; r < n; r++) {
+        xe[r] = xp[r];
+    }
+    for(int a = 0; a < m; a++) {
+        for(int r = 0; r < n; r++) {
+            xe[r] += K[r + a*n] * v[a];
+        }
+    }
+
+    // HP = rows index of Pp, scaled
+    for(int c = 0; c < n; c++) {
+        for(int a = 0; a < m; a++) {
+            const double s = scale != nullptr ? scale[a] : 1;
+            HP[a + c*m] = s * Pp[index[a] + c*n];
+        }
+    }
+
+    // Pe = Pp - K * HP
+    for(int c = 0; c < n; c++) {
+        for(int r = 0; r < n; r++) {
+            Pe[r + c*n] = Pp[r + c*n];
+        }
+        for(int a = 0; a < m; a++) {
+            const double hp = HP[a + c*m];
+            for(int r = 0; r < n; r++) {
+                Pe[r + c*n] -= K[r + a*n] * hp;
+            }
+        }
+    }
+    return 0;
+}
+
+
+/*
+ * Batched kernels for any lane count, the lane loops are left to the
+ * auto-vectorizer which handles long batches (eg. many tracks) well.
+*/
+void predictBatchAny(int n, int count, const double* KF_RESTRICT A,
+    const double* KF_RESTRICT Q, double* KF_RESTRICT x,
+    double* KF_RESTRICT P, double* KF_RESTRICT work) {
+    double* KF_RESTRICT xt = work;              // n lanes
+    double* KF_RESTRICT AP = work + n*count;    // n * n lanes
+
+    // x = A * x
+    for(int i = 0; i < n; i++) {
+        double* KF_RESTRICT out = xt + i*count;
+        for(int l = 0; l < count; l++) {
+            out[l] = 0;
+        }
+        for(int j = 0; j < n; j++) {
+            const double* KF_RESTRICT a = A + (i + j*n)*count;
+            const double* KF_RESTRICT xj = x + j*count;
+            for(int l = 0; l < count; l++) {
+                out[l] += a[l] * xj[l];
+            }
+        }
+    }
+    for(int i = 0; i < n*count; i++) {
+        x[i] = xt[i];
+    }
+
+    // AP = A * P
+    for(int c = 0; c < n; c++) {
+        for(int r = 0; r < n; r++) {
+            double* KF_RESTRICT out = AP + (r + c*n)*count;
+            for(int l = 0; l < count; l++) {
+                out[l] = 0;
+            }
+            for(int k = 0; k < n; k++) {
+                const double* KF_RESTRICT a = A + (r + k*n)*count;
+                const double* KF_RESTRICT p = P + (k + c*n)*count;
+                for(int l = 0; l < count; l++) {
+                    out[l] += a[l] * p[l];
+                }
+            }
+        }
+    }
+
+    // P = AP * A' + Q
+    for(int c = 0; c < n; c++) {
+        for(int r = 0; r < n; r++) {
+            double* KF_RESTRICT out = P + (r + c*n)*count;
+            const double* KF_RESTRICT q = Q + (r + c*n)*count;
+            for(int l = 0; l < count; l++) {
+                out[l] = q[l];
+            }
+            for(int k = 0; k < n; k++) {
+                const double* KF_RESTRICT ap = AP + (r + k*n)*count;
+                const double* KF_RESTRICT a = A + (c + k*n)*count;
+                for(int l = 0; l < count; l++) {
+                    out[l] += ap[l] * a[l];
+                }
+            }
+        }
+    }
+}
+
+
+void updateBatchAny(int n, int count, const double* KF_RESTRICT h, double r,
+    const double* KF_RESTRICT y, double* KF_RESTRICT x,
+    double* KF_RESTRICT P, double* KF_RESTRICT innov, double* KF_RESTRICT s,
+    double* KF_RESTRICT work) {
+    double* KF_RESTRICT ph = work;               // P * h', n lanes
+    double* KF_RESTRICT hp = ph + n*count;       // h * P, n lanes
+    double* KF_RESTRICT sv = hp + n*count;       // innovation variance
+    double* KF_RESTRICT v = sv + count;          // innovation
+
+    for(int i = 0; i < n; i++) {
+        double* KF_RESTRICT out_ph = ph + i*count;
+        double* KF_RESTRICT out_hp = hp + i*count;
+        for(int l = 0; l < count; l++) {
+            out_ph[l] = 0;
+            out_hp[l] = 0;
+        }
+        for(int k = 0; k < n; k++) {
+            const double* KF_RESTRICT p_ik = P + (i + k*n)*count;
+            const double* KF_RESTRICT p_ki = P + (k + i*n)*count;
+            const double hk = h[k];
+            for(int l = 0; l < count; l++) {
+                out_ph[l] += p_ik[l] * hk;
+                out_hp[l] += p_ki[l] * hk;
+            }
+        }
+    }
+
+    for(int l = 0; l < count; l++) {
+        sv[l] = r;
+        v[l] = y[l];
+    }
+    for(int k = 0; k < n; k++) {
+        const double hk = h[k];
+        const double* KF_RESTRICT phk = ph + k*count;
+        const double* KF_RESTRICT xk = x + k*count;
+        for(int l = 0; l < count; l++) {
+            sv[l] += hk * phk[l];
+            v[l] -= hk * xk[l];
+        }
+    }
+
+    if(innov != nullptr) {
+        for(int l = 0; l < count; l++) {
+            innov[l] = v[l];
+        }
+    }
+    if(s != nullptr) {
+        for(int l = 0; l < count; l++) {
+            s[l] = sv[l];
+        }
+    }
+
+    // turn ph into the gain K = P * h' / s and apply it
+    for(int l = 0; l < count; l++) {
+        sv[l] = 1 / sv[l];
+    }
+    for(int i = 0; i < n; i++) {
+        double* KF_RESTRICT k = ph + i*count;
+        double* KF_RESTRICT xi = x + i*count;
+        for(int l = 0; l < count; l++) {
+            k[l] *= sv[l];
+            xi[l] += k[l] * v[l];
+        }
+    }
+
+    // P = P - K * (h * P)
+    for(int c = 0; c < n; c++) {
+        const double* KF_RESTRICT hpc = hp + c*count;
+        for(int rr = 0; rr < n; rr++) {
+            double* KF_RESTRICT out = P + (rr + c*n)*count;
+            const double* KF_RESTRICT k = ph + rr*count;
+            for(int l = 0; l < count; l++) {
+                out[l] -= k[l] * hpc[l];
+            }
+        }
+    }
+}
+
+
+void mixBatchAny(int n, int models, int count, const double* KF_RESTRICT W,
+    const double* KF_RESTRICT x, const double* KF_RESTRICT P,
+    double* KF_RESTRICT x0, double* KF_RESTRICT P0) {
+
+    // x0 = sum_i W(i, :) x_i, source values are broadcast across the lanes
+    for(int e = 0; e < n; e++) {
+        double* KF_RESTRICT out = x0 + e*count;
+        for(int l = 0; l < count; l++) {
+            out[l] = 0;
+        }
+        for(int i = 0; i < models; i++) {
+            const double* KF_RESTRICT w = W + i*count;
+            const double xi = x[e*count + i];
+            for(int l = 0; l < count; l++) {
+                out[l] += w[l] * xi;
+            }
+        }
+    }
+
+    // P0 = sum_i W(i, :) (P_i + d * d'), d = x_i - x0, lower triangle
+    // then mirrored since P0 is symmetric
+    for(int c = 0; c < n; c++) {
+        const double* KF_RESTRICT x0c = x0 + c*count;
+        for(int r = c; r < n; r++) {
+            const double* KF_RESTRICT x0r = x0 + r*count;
+            double* KF_RESTRICT out = P0 + (r + c*n)*count;
+            for(int l = 0; l < count; l++) {
+                out[l] = 0;
+            }
+            for(int i = 0; i < models; i++) {
+                const double* KF_RESTRICT w = W + i*count;
+                const double p = P[(r + c*n)*count + i];
+                const double xr = x[r*count + i];
+                const double xc = x[c*count + i];
+                for(int l = 0; l < count; l++) {
+                    out[l] += w[l] * (p + (xr - x0r[l]) * (xc - x0c[l]));
+                }
+            }
+            if(r != c) {
+                double* KF_RESTRICT mirror = P0 + (c + r*n)*count;
+                for(int l = 0; l < count; l++) {
+                    mirror[l] = out[l];
+                }
+            }
+        }
+    }
+}
+
+
+/*
+ * Small fixed width batches (2, 4 or 8 lanes, eg. the models of an IMM
+ * bank) hold one element of W lanes in a GCC vector type, so each lane
+ * operation is a single SIMD expression of the ISA the file is built for
+ * and accumulators stay in registers. Left to the auto-vectorizer, the
+ * short lane loops get fully unrolled and the loops over states or models
+ * around them vectorized instead, with strided gathers. W is capped at
+ * the register width of the build, wider batches run as independent
+ * slices of W lanes.
+*/
+#if defined(__AVX512F__)
+constexpr int kRegisterLanes = 8;
+#elif defined(__AVX__)
+constexpr int kRegisterLanes = 4;
+#else
+constexpr int kRegisterLanes = 2;
+#endif
+
+template<int W>
+struct Lanes {
+    // W doubles, only double aligned since lane-major arrays are not padded
+    typedef double Vec __attribute__((vector_size(W * sizeof(double)),
+        aligned(sizeof(double)), may_alias));
+
+    // the W lanes of one element starting at p
+    static inline Vec& at(double* p) {
+        return *reinterpret_cast<Vec*>(p);
+    }
+
+    static inline const Vec& at(const double* p) {
+        return *reinterpret_cast<const Vec*>(p);
+    }
+};
+
+
+/**
+ * @brief predictBatch of W lanes out of a batch of stride lanes
+*/
+template<int W>
+void predictLanes(int n, int stride, const double* KF_RESTRICT A,
+    const double* KF_RESTRICT Q, double* KF_RESTRICT x,
+    double* KF_RESTRICT P, double* KF_RESTRICT work) {
+    typedef Lanes<W> L;
+    typedef typename L::Vec V;
+    double* KF_RESTRICT xt = work;              // n lanes
+    double* KF_RESTRICT AP = work + n*stride;   // n * n lanes
+
+    // x = A * x
+    for(int i = 0; i < n; i++) {
+        V acc = {};
+        for(int j = 0; j < n; j++) {
+            acc += L::at(A + (i + j*n)*stride) * L::at(x + j*stride);
+        }
+        L::at(xt + i*stride) = acc;
+    }
+    for(int i = 0; i < n; i++) {
+        L::at(x + i*stride) = L::at(xt + i*stride);
+    }
+
+    // AP = A * P, a column at a time so the n row accumulators are
+    // independent instead of one serial chain per element
+    for(int c = 0; c < n; c++) {
+        const V p0 = L::at(P + c*n*stride);
+        for(int r = 0; r < n; r++) {
+            L::at(AP + (r + c*n)*stride) = L::at(A + r*stride) * p0;
+        }
+        for(int k = 1; k < n; k++) {
+            const V pk = L::at(P + (k + c*n)*stride);
+            for(int r = 0; r < n; r++) {
+                L::at(AP + (r + c*n)*stride) += L::at(A + (r + k*n)*stride) * pk;
+            }
+        }
+    }
+
+    // P = AP * A' + Q, lower triangle then mirrored since P is symmetric
+    for(int c = 0; c < n; c++) {
+        for(int r = c; r < n; r++) {
+            L::at(P + (r + c*n)*stride) = L::at(Q + (r + c*n)*stride);
+        }
+        for(int k = 0; k < n; k++) {
+            const V a = L::at(A + (c + k*n)*stride);
+            for(int r = c; r < n; r++) {
+                L::at(P + (r + c*n)*stride) += L::at(AP + (r + k*n)*stride) * a;
+            }
+        }
+        for(int r = c + 1; r < n; r++) {
+            L::at(P + (c + r*n)*stride) = L::at(P + (r + c*n)*stride);
+        }
+    }
+}
+
+
+/**
+ * @brief updateBatch of W lanes out of a batch of stride lanes
+*/
+template<int W>
+void updateLanes(int n, int stride, const double* KF_RESTRICT h, double r,
+    const double* KF_RESTRICT y, double* KF_RESTRICT x,
+    double* KF_RESTRICT P, double* KF_RESTRICT innov, double* KF_RESTRICT s,
+    double* KF_RESTRICT work) {
+    typedef Lanes<W> L;
+    typedef typename L::Vec V;
+    double* KF_RESTRICT ph = work;            // P * h', n lanes
+    double* KF_RESTRICT hp = ph + n*stride;   // h * P, n lanes
+
+    V sv = V{} + r;          // innovation variance
+    V v = L::at(y);          // innovation
+    for(int i = 0; i < n; i++) {
+        V acc_ph = {};
+        V acc_hp = {};
+        for(int k = 0; k < n; k++) {
+            const double hk = h[k];
+            acc_ph += L::at(P + (i + k*n)*stride) * hk;
+            acc_hp += L::at(P + (k + i*n)*stride) * hk;
+        }
+        L::at(ph + i*stride) = acc_ph;
+        L::at(hp + i*stride) = acc_hp;
+        sv += h[i] * acc_ph;
+        v -= h[i] * L::at(x + i*stride);
+    }
+
+    if(innov != nullptr) {
+        L::at(innov) = v;
+    }
+    if(s != nullptr) {
+        L::at(s) = sv;
+    }
+
+    // turn ph into the gain K = P * h' / s and apply it
+    const V inv = 1 / sv;
+    for(int i = 0; i < n; i++) {
+        const V k = L::at(ph + i*stride) * inv;
+        L::at(ph + i*stride) = k;
+        L::at(x + i*stride) += k * v;
+    }
+
+    // P = P - K * (h * P)
+    for(int c = 0; c < n; c++) {
+        const V hpc = L::at(hp + c*stride);
+        for(int rr = 0; rr < n; rr++) {
+            L::at(P + (rr + c*n)*stride) -= L::at(ph + rr*stride) * hpc;
+        }
+    }
+}
+
+
+/**
+ * @brief mixBatch into W target lanes out of a batch of stride lanes,
+ *        x and P point at the (unsliced) source lanes
+*/
+template<int W>
+void mixLanes(int n, int models, int stride, const double* KF_RESTRICT w,
+    const double* KF_RESTRICT x, const double* KF_RESTRICT P,
+    double* KF_RESTRICT x0, double* KF_RESTRICT P0) {
+    typedef Lanes<W> L;
+    typedef typename L::Vec V;
+
+    // x0 = sum_i W(i, :) x_i, source values are broadcast across the lanes
+    for(int e = 0; e < n; e++) {
+        V acc = {};
+        for(int i = 0; i < models; i++) {
+            acc += L::at(w + i*stride) * x[e*stride + i];
+        }
+        L::at(x0 + e*stride) = acc;
+    }
+
+    // P0 = sum_i W(i, :) (P_i + d * d'), d = x_i - x0, lower triangle
+    // then mirrored since P0 is symmetric
+    for(int c = 0; c < n; c++) {
+        const V x0c = L::at(x0 + c*stride);
+        for(int r = c; r < n; r++) {
+            const V x0r = L::at(x0 + r*stride);
+            V acc = {};
+            for(int i = 0; i < models; i++) {
+                acc += L::at(w + i*stride) * (P[(r + c*n)*stride + i] +
+                    (x[r*stride + i] - x0r) * (x[c*stride + i] - x0c));
+            }
+            L::at(P0 + (r + c*n)*stride) = acc;
+            L::at(P0 + (c + r*n)*stride) = acc;
+        }
+    }
+}
+
+
+template<int C>
+void predictBatchN(int n, const double* A, const double* Q, double* x,
+    double* P, double* work) {
+    constexpr int W = C < kRegisterLanes ? C : kRegisterLanes;
+    for(int g = 0; g < C; g += W) {
+        predictLanes<W>(n, C, A + g, Q + g, x + g, P + g, work + g);
+    }
+}
+
+
+template<int C>
+void updateBatchN(int n, const double* h, double r, const double* y,
+    double* x, double* P, double* innov, double* s, double* work) {
+    constexpr int W = C < kRegisterLanes ? C : kRegisterLanes;
+    for(int g = 0; g < C; g += W) {
+        updateLanes<W>(n, C, h, r, y + g, x + g, P + g,
+            innov != nullptr ? innov + g : nullptr, s != nullptr ? s + g : nullptr,
+            work + g);
+    }
+}
+
+
+template<int C>
+void mixBatchN(int n, int models, const double* W, const double* x,
+    const double* P, double* x0, double* P0) {
+    constexpr int V = C < kRegisterLanes ? C : kRegisterLanes;
+    for(int g = 0; g < C; g += V) {
+        mixLanes<V>(n, models, C, W + g, x, P, x0 + g, P0 + g);
+    }
+}
+
+
+void predictBatch(int n, int count, const double* A, const double* Q,
+    double* x, double* P, double* work) {
+    switch(count) {
+        case 2:
+            predictBatchN<2>(n, A, Q, x, P, work);
+            break;
+        case 4:
+            predictBatchN<4>(n, A, Q, x, P, work);
+            break;
+        case 8:
+            predictBatchN<8>(n, A, Q, x, P, work);
+            break;
+        default:
+            predictBatchAny(n, count, A, Q, x, P, work);
+            break;
+    }
+}
+
+
+void updateBatch(int n, int count, const double* h, double r,
+    const double* y, double* x, double* P, double* innov, double* s,
+    double* work) {
+    switch(count) {
+        case 2:
+            updateBatchN<2>(n, h, r, y, x, P, innov, s, work);
+            break;
+        case 4:
+            updateBatchN<4>(n, h, r, y, x, P, innov, s, work);
+            break;
+        case 8:
+            updateBatchN<8>(n, h, r, y, x, P, innov, s, work);
+            break;
+        default:
+            updateBatchAny(n, count, h, r, y, x, P, innov, s, work);
+            break;
+    }
+}
+
+
+void mixBatch(int n, int models, int count, const double* W,
+    const double* x, const double* P, double* x0, double* P0) {
+    switch(count) {
+        case 2:
+            mixBatchN<2>(n, models, W, x, P, x0, P0);
+            break;
+        case 4:
+            mixBatchN<4>(n, models, W, x, P, x0, P0);
+            break;
+        case 8:
+            mixBatchN<8>(n, models, W, x, P, x0, P0);
+            break;
+        default:
+            mixBatchAny(n, models, count, W, x, P, x0, P0);
+            break;
+    }
+}
+
+
+void propagateShared(int n, int m, int count, const double* KF_RESTRICT A,
+    const double* KF_RESTRICT K, const double* KF_RESTRICT H,
+    const double* KF_RESTRICT y, double* KF_RESTRICT x,
+    double* KF_RESTRICT work) {
+    double* KF_RESTRICT xp = work;             // n lanes
+    double* KF_RESTRICT v = work + n*count;    // m lanes
+
+    // xp = A * x
+    for(int i = 0; i < n; i++) {
+        double* KF_RESTRICT out = xp + i*count;
+        for(int l = 0; l < count; l++) {
+            out[l] = 0;
+        }
+        for(int j = 0; j < n; j++) {
+            const double a = A[i + j*n];
+            const double* KF_RESTRICT xj = x + j*count;
+            for(int l = 0; l < count; l++) {
+                out[l] += a * xj[l];
+            }
+        }
+    }
+
+    if(y == nullptr) {
+        for(int i = 0; i < n*count; i++) {
+            x[i] = xp[i];
+        }
+        return;
+    }
+
+    // v = y - H * xp
+    for(int a = 0; a < m; a++) {
+        double* KF_RESTRICT va = v + a*count;
+        const double* KF_RESTRICT ya = y + a*count;
+        for(int l = 0; l < count; l++) {
+            va[l] = ya[l];
+        }
+        for(int k = 0; k < n; k++) {
+            const double h = H[a + k*m];
+            const double* KF_RESTRICT xk = xp + k*count;
+            for(int l = 0; l < count; l++) {
+                va[l] -= h * xk[l];
+            }
+        }
+    }
+
+    // x = xp + K * v
+    for(int i = 0; i < n; i++) {
+        double* KF_RESTRICT xi = x + i*count;
+        const double* KF_RESTRICT xpi = xp + i*count;
+        for(int l = 0; l < count; l++) {
+            xi[l] = xpi[l];
+        }
+        for(int a = 0; a < m; a++) {
+            const double k = K[i + a*n];
+            const double* KF_RESTRICT va = v + a*count;
+            for(int l = 0; l < count; l++) {
+                xi[l] += k * va[l];
+            }
+        }
+    }
+}
+
+}  // namespace
+
+
+extern const KernelTable KF_KERNEL_TABLE = {
+    KF_KERNEL_NAME,
+    &predict,
+    &update,
+    &updateIndexed,
+    &predictBatch,
+    &updateBatch,
+    &propagateShared,
+    &mixBatch
+};
+
+#undef KF_RESTRICT
@@ -0,0 +1,200 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @file observation_model.cpp
+ * @author Rishabh Mukund (rishabh.m96@gmail.com)
+ * @brief Observation model (H) with its structure
+ * @version 1.0
+ * @date 18/10/2026
+ *
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+*/
+
+#include "observation_model.hpp"
+
+#include<stdexcept>
+
+
+using namespace Eigen;
+using namespace std;
+
+ObservationModel::ObservationModel(Type type, const MatrixXd& H,
+    const vector<int>& indices, const VectorXd& scales)
+    : type_(type),
+      H_(H),
+      indices_(indices),
+      scales_(scales)
+    {
+    }
+
+
+/**
+ * @brief dense observation model
+ * 
+ * @param H (MatrixXd) - Obervation matrix
+ * 
+ * @return (ObservationModel) - dense model
+*/
+ObservationModel ObservationModel::dense(const MatrixXd& H) {
+    return ObservationModel(Type::Dense, H, vector<int>(), VectorXd());
+}
+
+
+/**
+ * @brief observation model picking state components directly
+ * 
+ * @param num_states (int) - Number of state parameters
+ * @param indices (vector<int>) - observed state index per measurement
+ * 
+ * @return (ObservationModel) - selection model
+*/
+ObservationModel ObservationModel::selection(int num_states, const vector<int>& indices) {
+    ObservationModel model = diagonalScaled(num_states, indices,
+        VectorXd::Ones(indices.size()));
+    model.type_ = Type::Selection;
+    return model;
+}
+
+
+/**
+ * @brief observation model picking scaled state components
+ * 
+ * @param num_states (int) - Number of state parameters
+ * @param indices (vector<int>) - observed state index per measurement
+ * @param scales (VectorXd) - scale per measurement
+ * 
+ * @return (ObservationModel) - diagonal scaled model
+*/
+ObservationModel ObservationModel::diagonalScaled(int num_states,
+    const vector<int>& indices, const VectorXd& scales) {
+    if(scales.size() != static_cast<Index>(indices.size())) {
+        throw runtime_error("Invalid dimension for obeservation matrix.");
+    }
+
+    MatrixXd H = MatrixXd::Zero(indices.size(), num_states);
+    for(size_t a = 0; a < indices.size(); a++) {
+        if(indices[a] < 0 || indices[a] >= num_states) {
+            throw runtime_error("Invalid state index in obeservation model.");
+        }
+        H(a, indices[a]) = scales(a);
+    }
+    return ObservationModel(Type::DiagonalScaled, H, indices, scales);
+}
+
+
+/**
+ * @brief observation model of the most specific type that matches H
+ * 
+ * @param H (MatrixXd) - Obervation matrix
+ * 
+ * @return (ObservationModel) - selection, diagonal scaled or dense model
+*/
+ObservationModel ObservationModel::fromMatrix(const MatrixXd& H) {
+    vector<int> indices(H.rows());
+    VectorXd scales(H.rows());
+    bool unit = true;
+
+    for(Index a = 0; a < H.rows(); a++) {
+        int nonzero = 0;
+        for(Index i = 0; i < H.cols(); i++) {
+            if(H(a, i) != 0) {
+                indices[a] = static_cast<int>(i);
+                scales(a) = H(a, i);
+                nonzero++;
+            }
+        }
+        if(nonzero != 1) {
+            return dense(H);
+        }
+        unit = unit && scales(a) == 1;
+    }
+
+    return unit ? selection(static_cast<int>(H.cols()), indices)
+                : diagonalScaled(static_cast<int>(H.cols()), indices, scales);
+}
+
+
+/**
+ * @brief get structure of the model
+ * 
+ * @return (Type) - model type
+*/
+ObservationModel::Type ObservationModel::type() const {
+    return type_;
+}
+
+
+/**
+ * @brief get dense form of the model
+ * 
+ * @return (MatrixXd) - Obervation matrix
+*/
+const MatrixXd& ObservationModel::matrix() const {
+    return H_;
+}
+
+
+/**
+ * @brief get observed state index per measurement (not for Dense)
+ * 
+ * @return (vector<int>) - state indices
+*/
+const vector<int>& ObservationModel::indices() const {
+    return indices_;
+}
+
+
+/**
+ * @brief get scale per measurement (not for Dense)
+ * 
+ * @return (VectorXd) - scales
+*/
+const VectorXd& ObservationModel::scales() const {
+    return scales_;
+}
+
+
+/**
+ * @brief run the update kernel that matches the structure of the model
+ * 
+ * @param kernels (KernelTable) - kernels of the active ISA level
+ * 
+ * @return (int) - 0 on success, non zero if innovation covariance is singular
+*/
+int ObservationModel::update(const KernelTable& kernels, const double* R,
+    const double* y, const double* xp, const double* Pp, double* xe,
+    double* Pe, double* K, double* work) const {
+    const int n = static_cast<int>(H_.cols());
+    const int m = static_cast<int>(H_.rows());
+
+    switch(type_) {
+        case Type::Selection:
+            return kernels.updateIndexed(n, m, indices_.data(), nullptr, R, y,
+                xp, Pp, xe, Pe, K, work);
+        case Type::DiagonalScaled:
+            return kernels.updateIndexed(n, m, indices_.data(), scales_.data(),
+                R, y, xp, Pp, xe, Pe, K, work);
+        default:
+            return kernels.update(n, m, H_.data(), R, y, xp, Pp, xe, Pe, K, work);
+    }
+}
\ No newline at end of file
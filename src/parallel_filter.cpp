@@ -0,0 +1,703 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @file parallel_filter.cpp
+ * @author Rishabh Mukund (rishabh.m96@gmail.com)
+ * @brief Parallel-in-time Kalman filter and smoother for offline logs
+ * @version 1.0
+ * @date 18/10/2026
+ *
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+*/
+
+#include "parallel_filter.hpp"
+#include "cpu_dispatch.hpp"
+
+#include<algorithm>
+#include<stdexcept>
+#include<utility>
+
+
+using namespace Eigen;
+using namespace std;
+
+namespace {
+
+// below this many steps per chunk the scan costs more than it saves
+const size_t kMinChunkSteps = 64;
+
+// affine coefficients below this no longer matter at double precision,
+// their squares would already underflow
+const double kNegligible = 1e-150;
+
+
+/**
+ * @brief Filtering element, the conditional p(x_k | x_j, y_j+1..k) =
+ *        N(A x_j + b, C) with the likelihood of y_j+1..k in information
+ *        form (eta, J)
+*/
+struct FilterElement {
+    MatrixXd A;
+    VectorXd b;
+    MatrixXd C;
+    VectorXd eta;
+    MatrixXd J;
+
+    explicit FilterElement(int n)
+        : A(MatrixXd::Zero(n, n)), b(VectorXd::Zero(n)), C(MatrixXd::Zero(n, n)),
+          eta(VectorXd::Zero(n)), J(MatrixXd::Zero(n, n)) {}
+};
+
+
+/**
+ * @brief Smoothing element, p(x_k | x_j, y_1..n) = N(E x_j + g, L)
+*/
+struct SmoothElement {
+    MatrixXd E;
+    VectorXd g;
+    MatrixXd L;
+
+    explicit SmoothElement(int n)
+        : E(MatrixXd::Zero(n, n)), g(VectorXd::Zero(n)), L(MatrixXd::Zero(n, n)) {}
+};
+
+
+/**
+ * @brief scratch space of one chunk, sized once so building, combining and
+ *        applying elements does not allocate
+ * @details m is the largest measurement size of the log, steps with fewer
+ *          measurements resize HC, S, ... (and allocate) on the way.
+*/
+struct ChunkWork {
+    MatrixXd M;    // I + J_j * C_i of a combine
+    MatrixXd Tt;   // transposed T of a combine, smoother gain before transpose
+    MatrixXd Ut;   // transposed U of a combine
+    MatrixXd nn;   // n x n product
+    VectorXd v;    // n vector
+    PartialPivLU<MatrixXd> lu;
+
+    MatrixXd HC;    // H * C
+    MatrixXd S;     // innovation covariance H * C * H' + R
+    MatrixXd Kt;    // transposed gain S^-1 * H * C
+    MatrixXd HA;    // H * A
+    MatrixXd SiHA;  // S^-1 * H * A
+    VectorXd r;     // innovation y - H * b
+    LDLT<MatrixXd> ldlt_m;
+    LDLT<MatrixXd> ldlt_n;
+
+    VectorXd xp;          // predicted state of the sequential filter
+    MatrixXd Pp;          // predicted covariance of the sequential filter
+    VectorXd xn;          // next estimate of the sequential filter
+    MatrixXd Pn;          // next covariance of the sequential filter
+    MatrixXd K;           // gain of the sequential filter
+    VectorXd zero_b;      // B * u of steps without control
+    vector<double> work;  // scratch space of the kernels
+
+    FilterElement scanned;  // output of a filtering combine in the scan
+    SmoothElement folded;   // output of a smoothing fold or combine
+
+    ChunkWork(int n, int m)
+        : M(n, n), Tt(n, n), Ut(n, n), nn(n, n), v(n), lu(n),
+          HC(m, n), S(m, m), Kt(m, n), HA(m, n), SiHA(m, n), r(m),
+          ldlt_m(m), ldlt_n(n),
+          xp(n), Pp(n, n), xn(n), Pn(n, n), K(n, m), zero_b(VectorXd::Zero(n)),
+          work(max(n * n, 2 * n * m + 2 * m * m + m)),
+          scanned(n), folded(n) {}
+};
+
+
+/**
+ * @brief X = S^-1 * B from the LDLT of S, a column at a time
+ * @details Eigen's solve for a matrix right hand side goes through the
+ *          blocked triangular solver, whose setup costs more than the whole
+ *          solve at filter sizes.
+*/
+void solveColumns(const LDLT<MatrixXd>& ldlt, const MatrixXd& B, MatrixXd& X) {
+    X.resize(B.rows(), B.cols());
+    for(Index c = 0; c < B.cols(); c++) {
+        X.col(c) = ldlt.solve(B.col(c));
+    }
+}
+
+
+/**
+ * @brief combine filtering elements, earlier i with later j, into out
+ * @details T = A_j (I + C_i J_j)^-1 and U = A_i' (I + J_j C_i)^-1 both come
+ *          from one LU of M = I + J_j C_i, since C and J are symmetric.
+*/
+void combine(const FilterElement& i, const FilterElement& j, FilterElement& out,
+    ChunkWork& w) {
+    w.M.noalias() = j.J * i.C;
+    w.M.diagonal().array() += 1;
+    w.lu.compute(w.M);
+    w.Tt = w.lu.solve(j.A.transpose());
+    w.Ut = w.lu.transpose().solve(i.A);
+
+    out.A.noalias() = w.Tt.transpose() * i.A;
+    w.v = i.b;
+    w.v.noalias() += i.C * j.eta;
+    out.b = j.b;
+    out.b.noalias() += w.Tt.transpose() * w.v;
+    w.nn.noalias() = i.C * j.A.transpose();
+    out.C = j.C;
+    out.C.noalias() += w.Tt.transpose() * w.nn;
+
+    w.v = j.eta;
+    w.v.noalias() -= j.J * i.b;
+    out.eta = i.eta;
+    out.eta.noalias() += w.Ut.transpose() * w.v;
+    w.nn.noalias() = j.J * i.A;
+    out.J = i.J;
+    out.J.noalias() += w.Ut.transpose() * w.nn;
+}
+
+
+/**
+ * @brief combine smoothing elements, earlier i with later j, into out
+*/
+void combine(const SmoothElement& i, const SmoothElement& j, SmoothElement& out,
+    ChunkWork& w) {
+    out.E.noalias() = i.E * j.E;
+    out.g = i.g;
+    out.g.noalias() += i.E * j.g;
+    w.nn.noalias() = i.E * j.L;
+    out.L = i.L;
+    out.L.noalias() += w.nn * i.E.transpose();
+}
+
+
+/**
+ * @brief in place inclusive scan at(k) = op(at(0), ..., at(k)) over the
+ *        count chunk summaries, with an up-sweep and a down-sweep of
+ *        ceil(log2(count)) levels each run on the pool
+ * @details op(earlier, later, w) must be associative and leaves the result
+ *          in later. Within a level every k is written once, so work[k] is
+ *          the scratch space of its combine.
+*/
+template<typename At, typename Op>
+void inclusiveScan(size_t count, At at, Op op, vector<ChunkWork>& work,
+    ThreadPool& pool) {
+    size_t levels = 0;
+    while((size_t(1) << levels) < count) {
+        levels++;
+    }
+
+    for(size_t d = 0; d < levels; d++) {
+        const size_t stride = size_t(1) << (d + 1);
+        const size_t half = size_t(1) << d;
+        pool.parallelFor(0, (count + stride - 1) / stride, [&](size_t first, size_t last) {
+            for(size_t t = first; t < last; t++) {
+                const size_t k = t * stride + stride - 1;
+                if(k < count) {
+                    op(at(k - half), at(k), work[k]);
+                }
+            }
+        });
+    }
+
+    for(size_t d = levels; d-- > 0;) {
+        const size_t stride = size_t(1) << (d + 1);
+        const size_t half = size_t(1) << d;
+        pool.parallelFor(0, (count + stride - 1) / stride, [&](size_t first, size_t last) {
+            for(size_t t = first; t < last; t++) {
+                const size_t j = t * stride + stride - 1;
+                const size_t k = j + half;
+                if(k < count) {
+                    op(at(j), at(k), work[k]);
+                }
+            }
+        });
+    }
+}
+
+
+/**
+ * @brief one predict/update step of the sequential filter from the
+ *        estimate (x, P) into (xe, Pe)
+*/
+void filterStep(const KernelTable& kt, const FilterStep& step, const MatrixXd& H0,
+    const MatrixXd& Q, const double* x, const double* P, double* xe, double* Pe,
+    ChunkWork& w) {
+    const int n = static_cast<int>(Q.rows());
+    const bool control = step.B.size() != 0 && step.u.size() != 0;
+
+    // a predict only step leaves the prediction as the estimate
+    const bool measured = step.y.size() != 0;
+    kt.predict(n, step.A.data(), control ? step.B.data() : w.zero_b.data(),
+        control ? step.u(0) : 0, Q.data(), x, P, measured ? w.xp.data() : xe,
+        measured ? w.Pp.data() : Pe, w.work.data());
+    if(!measured) {
+        return;
+    }
+
+    const MatrixXd& H = step.H.size() == 0 ? H0 : step.H;
+    const int m = static_cast<int>(step.y.size());
+    w.K.resize(n, m);
+    if(kt.update(n, m, H.data(), step.R.data(), step.y.data(), w.xp.data(),
+           w.Pp.data(), xe, Pe, w.K.data(), w.work.data()) != 0) {
+        throw runtime_error("Singular innovation covariance in update step.");
+    }
+}
+
+
+/**
+ * @brief filtering element of steps [begin, end), the filter run with the
+ *        state before begin known
+ * @details The estimate stays affine in that state (A, b) with a covariance
+ *          C that does not depend on it, and every innovation adds its
+ *          likelihood in x to (eta, J). A decays as fast as the filter
+ *          forgets its prior, from there on the chunk is the plain filter,
+ *          so no combine is needed per step.
+*/
+void chunkElement(const vector<FilterStep>& steps, size_t begin, size_t end,
+    const MatrixXd& H0, const MatrixXd& Q, FilterElement& e, ChunkWork& w) {
+    e.A.setIdentity();
+    e.b.setZero();
+    e.C.setZero();
+    e.eta.setZero();
+    e.J.setZero();
+    const KernelTable& kt = kernels();
+    bool coupled = true;  // estimate still depends on the state before begin
+
+    for(size_t k = begin; k < end; k++) {
+        const FilterStep& step = steps[k];
+        if(!coupled) {
+            filterStep(kt, step, H0, Q, e.b.data(), e.C.data(), w.xn.data(),
+                w.Pn.data(), w);
+            e.b.swap(w.xn);
+            e.C.swap(w.Pn);
+            continue;
+        }
+        w.nn.noalias() = step.A * e.A;
+        e.A.swap(w.nn);
+        w.v.noalias() = step.A * e.b;
+        if(step.B.size() != 0 && step.u.size() != 0) {
+            w.v.noalias() += step.B * step.u;
+        }
+        e.b.swap(w.v);
+        w.nn.noalias() = step.A * e.C;
+        e.C = Q;
+        e.C.noalias() += w.nn * step.A.transpose();
+        if(step.y.size() == 0) {
+            continue;
+        }
+
+        // innovation y - H * (A x + b) with covariance S, the gain
+        // K = C * H' * S^-1 is kept transposed as S^-1 * H * C
+        const MatrixXd& H = step.H.size() == 0 ? H0 : step.H;
+        w.HC.noalias() = H * e.C;
+        w.S = step.R;
+        w.S.noalias() += w.HC * H.transpose();
+        w.ldlt_m.compute(w.S);
+        if(w.ldlt_m.info() != Success) {
+            throw runtime_error("Singular innovation covariance in update step.");
+        }
+        w.r = step.y;
+        w.r.noalias() -= H * e.b;
+        solveColumns(w.ldlt_m, w.HC, w.Kt);
+        w.HA.noalias() = H * e.A;
+        solveColumns(w.ldlt_m, w.HA, w.SiHA);
+
+        e.J.noalias() += w.HA.transpose() * w.SiHA;
+        e.eta.noalias() += w.SiHA.transpose() * w.r;
+        e.A.noalias() -= w.Kt.transpose() * w.HA;
+        e.b.noalias() += w.Kt.transpose() * w.r;
+        e.C.noalias() -= w.Kt.transpose() * w.HC;
+
+        // once the start state is forgotten A only keeps shrinking through
+        // subnormals, which are very slow, so it is dropped and the rest of
+        // the chunk is the plain filter
+        if(e.A.cwiseAbs().maxCoeff() < kNegligible) {
+            e.A.setZero();
+            coupled = false;
+        }
+    }
+}
+
+
+/**
+ * @brief run the sequential filter over steps [begin, end) starting from
+ *        the estimate (x, P) before begin
+*/
+void filterRange(const vector<FilterStep>& steps, size_t begin, size_t end,
+    const MatrixXd& H0, const MatrixXd& Q, const VectorXd& x, const MatrixXd& P,
+    vector<VectorXd>& xe, vector<MatrixXd>& Pe, ChunkWork& w) {
+    const KernelTable& kt = kernels();
+    const int n = static_cast<int>(x.size());
+
+    for(size_t k = begin; k < end; k++) {
+        xe[k].resize(n);
+        Pe[k].resize(n, n);
+        filterStep(kt, steps[k], H0, Q, k == begin ? x.data() : xe[k - 1].data(),
+            k == begin ? P.data() : Pe[k - 1].data(), xe[k].data(), Pe[k].data(), w);
+    }
+}
+
+
+/**
+ * @brief number of chunks a log of count steps is split in, one per thread
+ *        while every chunk keeps kMinChunkSteps steps
+*/
+size_t numChunks(size_t count, int threads) {
+    return max<size_t>(1, min<size_t>(threads, count / kMinChunkSteps));
+}
+
+
+/**
+ * @brief first step of chunk c out of chunks
+*/
+size_t chunkBegin(size_t count, size_t chunks, size_t c) {
+    return c * count / chunks;
+}
+
+}  // namespace
+
+
+/**
+ * @brief Constructor for ParallelKalmanFilter class
+ * 
+ * @param num_states (int) - Number of state parameters
+ * @param num_measurements (int) - Number of independent measurements
+ * @param num_threads (int) - Number of threads, 0 uses the hardware concurrency
+*/
+ParallelKalmanFilter::ParallelKalmanFilter(int num_states, int num_measurements,
+    int num_threads)
+    : num_states_(num_states),
+      num_measurements_(num_measurements),
+      H_(num_measurements, num_states),
+      Q_(num_states, num_states),
+      pool_(num_threads)
+    {
+    }
+
+
+/**
+ * @brief set obervation matrix (H) of system
+ * 
+ * @param H (MatrixXd) - Obervation matrix 
+*/
+void ParallelKalmanFilter::setObervationMatrix(const MatrixXd& H) {
+    if(H.rows() != num_measurements_ || H.cols() != num_states_) {
+        throw runtime_error("Invalid dimension for obeservation matrix.");
+    }
+    H_ = H;
+}
+
+
+/**
+ * @brief set initial state of the system
+ * 
+ * @param xi (VectorXd) - Initial state vector
+ * @param Pi (MatrixXd) - Initial Process Covariance Matrix
+*/
+void ParallelKalmanFilter::setInitState(const VectorXd& xi, const MatrixXd& Pi) {
+    if(xi.size() != num_states_ || Pi.rows() != num_states_ ||
+       Pi.cols() != num_states_ ) {
+        throw runtime_error("Invalid dimensions for system state.");
+    }
+    xi_ = xi;
+    Pi_ = Pi;
+}
+
+
+/**
+ * @brief set noise covariance matrix (Q) of system
+ * 
+ * @param Q (MatrixXd) - Noise covariance matrix
+*/
+void ParallelKalmanFilter::setNoiseCovariance(const MatrixXd& Q) {
+    if(Q.rows() != num_states_ || Q.cols() != num_states_) {
+        throw runtime_error("Invalid dimension for noise covariance matrix.");
+    }
+    Q_ = Q;
+}
+
+
+void ParallelKalmanFilter::checkStep(const FilterStep& step) const {
+    if(step.A.rows() != num_states_ || step.A.cols() != num_states_ ||
+       (step.B.size() != 0 && (step.B.rows() != num_states_ || step.B.cols() != 1)) ||
+       (step.u.size() != 0 && step.u.size() != 1)) {
+        throw runtime_error("Invalid dimensions for state matrices.");
+    }
+    if(step.y.size() == 0) {
+        return;
+    }
+    const int m = static_cast<int>(step.y.size());
+    if(step.H.size() == 0 ? m != num_measurements_
+                          : (step.H.rows() != m || step.H.cols() != num_states_)) {
+        throw runtime_error("Invalid dimension for obeservation matrix.");
+    }
+    if(step.R.rows() != m || step.R.cols() != m) {
+        throw runtime_error("Invalid dimension for Observation noise covariance matrix.");
+    }
+}
+
+
+
+
+/**
+ * @brief run the filter over all steps of a log
+ * 
+ * @param steps (vector<FilterStep>) - predict/update steps in time order
+*/
+void ParallelKalmanFilter::filter(const vector<FilterStep>& steps) {
+    if(xi_.size() != num_states_) {
+        throw runtime_error("Initial state not set.");
+    }
+    int max_m = 0;
+    for(const FilterStep& step : steps) {
+        checkStep(step);
+        max_m = max(max_m, static_cast<int>(step.y.size()));
+    }
+
+    const int n = num_states_;
+    const size_t count = steps.size();
+    const size_t chunks = numChunks(count, pool_.size());
+    vector<ChunkWork> work(chunks, ChunkWork(n, max_m));
+    vector<FilterElement> summary(chunks, FilterElement(n));
+    xe_.resize(count);
+    Pe_.resize(count);
+
+    // chunk 0 filters from the prior, every other chunk but the last
+    // reduces its steps to one element
+    pool_.parallelFor(0, chunks, [&](size_t first, size_t last) {
+        for(size_t c = first; c < last; c++) {
+            ChunkWork& w = work[c];
+            const size_t begin = chunkBegin(count, chunks, c);
+            const size_t end = chunkBegin(count, chunks, c + 1);
+            if(c == 0) {
+                filterRange(steps, begin, end, H_, Q_, xi_, Pi_, xe_, Pe_, w);
+            }
+            else if(c + 1 < chunks) {
+                chunkElement(steps, begin, end, H_, Q_, summary[c], w);
+            }
+        }
+    });
+
+    // the estimate after chunk 0 as an element with A, eta and J zero, so
+    // the scan leaves the estimate after chunk c in summary[c] (b and C)
+    if(chunks > 1) {
+        const size_t k = chunkBegin(count, chunks, 1) - 1;
+        summary[0].b = xe_[k];
+        summary[0].C = Pe_[k];
+    }
+    inclusiveScan(chunks - 1, [&](size_t c) -> FilterElement& { return summary[c]; },
+        [](FilterElement& i, FilterElement& j, ChunkWork& w) {
+            combine(i, j, w.scanned, w);
+            swap(j, w.scanned);
+        }, work, pool_);
+
+    // every other chunk filters its steps again from its start estimate
+    pool_.parallelFor(1, chunks, [&](size_t first, size_t last) {
+        for(size_t c = first; c < last; c++) {
+            filterRange(steps, chunkBegin(count, chunks, c),
+                chunkBegin(count, chunks, c + 1), H_, Q_, summary[c - 1].b,
+                summary[c - 1].C, xe_, Pe_, work[c]);
+        }
+    });
+
+    xs_.clear();
+    Ps_.clear();
+}
+
+
+/**
+ * @brief run the Rauch-Tung-Striebel smoother as a reverse scan over
+ *        the filtered estimates
+ * 
+ * @param steps (vector<FilterStep>) - same steps last given to filter()
+*/
+void ParallelKalmanFilter::smooth(const vector<FilterStep>& steps) {
+    if(steps.size() != xe_.size()) {
+        throw runtime_error("Run filter() on the same steps before smooth().");
+    }
+    const int n = num_states_;
+    const size_t count = steps.size();
+    const size_t chunks = numChunks(count, pool_.size());
+    vector<ChunkWork> work(chunks, ChunkWork(n, 0));
+    vector<SmoothElement> summary(chunks, SmoothElement(n));
+    xs_.resize(count);
+    Ps_.resize(count);
+    Gs_.resize(count);
+
+    // element of step k: gain E in Gs_[k], g in xs_[k] and L in Ps_[k]
+    auto element = [&](size_t k, ChunkWork& w) {
+        if(k + 1 == count) {
+            Gs_[k].setZero(n, n);
+            xs_[k] = xe_[k];
+            Ps_[k] = Pe_[k];
+            return;
+        }
+        // E = Pe * A' * Pp^-1 is solved transposed, Pp and Pe are symmetric
+        const FilterStep& next = steps[k + 1];
+        w.nn.noalias() = next.A * Pe_[k];
+        w.Pp = Q_;
+        w.Pp.noalias() += w.nn * next.A.transpose();
+        w.ldlt_n.compute(w.Pp);
+        solveColumns(w.ldlt_n, w.nn, w.Tt);
+        Gs_[k] = w.Tt.transpose();
+
+        w.v.noalias() = next.A * xe_[k];
+        if(next.B.size() != 0 && next.u.size() != 0) {
+            w.v.noalias() += next.B * next.u;
+        }
+        xs_[k] = xe_[k];
+        xs_[k].noalias() -= Gs_[k] * w.v;
+        Ps_[k] = Pe_[k];
+        Ps_[k].noalias() -= Gs_[k] * w.nn;
+    };
+
+    // smoothed estimate of step k from the smoothed estimate (x, P) after it
+    auto apply = [&](size_t k, const VectorXd& x, const MatrixXd& P, ChunkWork& w) {
+        xs_[k].noalias() += Gs_[k] * x;
+        w.nn.noalias() = Gs_[k] * P;
+        Ps_[k].noalias() += w.nn * Gs_[k].transpose();
+    };
+
+    // the last chunk smooths back from the end, every other chunk builds
+    // its step elements and all but chunk 0 reduce them to one element
+    pool_.parallelFor(0, chunks, [&](size_t first, size_t last) {
+        for(size_t c = first; c < last; c++) {
+            ChunkWork& w = work[c];
+            const size_t begin = chunkBegin(count, chunks, c);
+            const size_t end = chunkBegin(count, chunks, c + 1);
+            if(c + 1 == chunks) {
+                for(size_t k = end; k-- > begin;) {
+                    element(k, w);
+                    if(k + 1 < count) {
+                        apply(k, xs_[k + 1], Ps_[k + 1], w);
+                    }
+                }
+                continue;
+            }
+
+            if(c == 0) {
+                for(size_t k = end; k-- > begin;) {
+                    element(k, w);
+                }
+                continue;
+            }
+
+            SmoothElement& s = summary[c];
+            element(end - 1, w);
+            s.E = Gs_[end - 1];
+            s.g = xs_[end - 1];
+            s.L = Ps_[end - 1];
+            bool coupled = true;  // s still depends on the state after the chunk
+            for(size_t k = end - 1; k-- > begin;) {
+                element(k, w);
+                if(coupled) {
+                    // same as the filter, a vanishing E is dropped before
+                    // it reaches subnormals
+                    w.folded.E.noalias() = Gs_[k] * s.E;
+                    if(w.folded.E.cwiseAbs().maxCoeff() < kNegligible) {
+                        w.folded.E.setZero();
+                        coupled = false;
+                    }
+                }
+                else {
+                    w.folded.E.setZero();
+                }
+                w.folded.g = xs_[k];
+                w.folded.g.noalias() += Gs_[k] * s.g;
+                w.nn.noalias() = Gs_[k] * s.L;
+                w.folded.L = Ps_[k];
+                w.folded.L.noalias() += w.nn * Gs_[k].transpose();
+                swap(s, w.folded);
+            }
+        }
+    });
+
+    // the smoothed estimate before the last chunk as an element with E
+    // zero, scanned from the last chunk backwards so summary[c] ends up
+    // with the smoothed estimate before chunk c (g and L)
+    {
+        SmoothElement& s = summary[chunks - 1];
+        const size_t k = chunkBegin(count, chunks, chunks - 1);
+        s.E.setZero();
+        s.g = xs_[k];
+        s.L = Ps_[k];
+    }
+    inclusiveScan(chunks - 1,
+        [&](size_t i) -> SmoothElement& { return summary[chunks - 1 - i]; },
+        [](SmoothElement& later, SmoothElement& earlier, ChunkWork& w) {
+            combine(earlier, later, w.folded, w);
+            swap(earlier, w.folded);
+        }, work, pool_);
+
+    // every other chunk smooths its steps from the estimate after it
+    pool_.parallelFor(0, chunks - 1, [&](size_t first, size_t last) {
+        for(size_t c = first; c < last; c++) {
+            const size_t begin = chunkBegin(count, chunks, c);
+            const size_t end = chunkBegin(count, chunks, c + 1);
+            for(size_t k = end; k-- > begin;) {
+                if(k + 1 == end) {
+                    apply(k, summary[c + 1].g, summary[c + 1].L, work[c]);
+                }
+                else {
+                    apply(k, xs_[k + 1], Ps_[k + 1], work[c]);
+                }
+            }
+        }
+    });
+}
+
+
+/**
+ * @brief get Estimated state vectors, one per step
+ * 
+ * @return (vector<VectorXd>) - Estimated state vectors
+*/
+const vector<VectorXd>& ParallelKalmanFilter::getStateEstimates() const {
+    return xe_;
+}
+
+
+/**
+ * @brief get Estimated Process Covariance Matrices, one per step
+ * 
+ * @return (vector<MatrixXd>) - Estimated Process Covariance Matrices
+*/
+const vector<MatrixXd>& ParallelKalmanFilter::getCovarianceEstimates() const {
+    return Pe_;
+}
+
+
+/**
+ * @brief get Smoothed state vectors, one per step
+ * 
+ * @return (vector<VectorXd>) - Smoothed state vectors
+*/
+const vector<VectorXd>& ParallelKalmanFilter::getSmoothedStates() const {
+    return xs_;
+}
+
+
+/**
+ * @brief get Smoothed Process Covariance Matrices, one per step
+ * 
+ * @return (vector<MatrixXd>) - Smoothed Process Covariance Matrices
+*/
+const vector<MatrixXd>& ParallelKalmanFilter::getSmoothedCovariances() const {
+    return Ps_;
+}
@@ -0,0 +1,322 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @file replay.cpp
+ * @author Rishabh Mukund (rishabh.m96@gmail.com)
+ * @brief Timestamp driven replay of sensor logs with latency measurement
+ * @version 1.0
+ * @date 18/10/2026
+ *
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+*/
+
+#include "replay.hpp"
+#include "utils.hpp"
+
+#include<algorithm>
+#include<chrono>
+#include<cmath>
+#include<condition_variable>
+#include<deque>
+#include<mutex>
+#include<numeric>
+#include<random>
+#include<stdexcept>
+#include<thread>
+
+
+using namespace std;
+
+namespace {
+
+using Clock = chrono::steady_clock;
+
+/**
+ * @brief Event waiting in the replay queue
+*/
+struct Arrival {
+    size_t index;             // index into the replayed events
+    Clock::time_point time;   // time the event reached the queue
+};
+
+
+/**
+ * @brief Event with the time (ms after replay start) it should arrive at
+*/
+struct Delivery {
+    double offset_ms;
+    size_t index;
+};
+
+
+/**
+ * @brief build arrival schedule from timestamps, speed and disturbances
+*/
+vector<Delivery> buildSchedule(const vector<SensorEvent>& events,
+    const ReplayConfig& config) {
+    const size_t n = events.size();
+    vector<Delivery> schedule(n);
+    mt19937 generator(config.seed);
+    normal_distribution<double> jitter(0, config.jitter_ms > 0 ? config.jitter_ms : 1);
+    bernoulli_distribution burst(min(max(config.burst_prob, 0.0), 1.0));
+    bernoulli_distribution reorder(min(max(config.reorder_prob, 0.0), 1.0));
+
+    for(size_t i = 0; i < n; i++) {
+        schedule[i].index = i;
+        schedule[i].offset_ms = config.speed > 0
+            ? (events[i].timestamp - events[0].timestamp) / config.speed
+            : 0;
+        if(config.jitter_ms > 0) {
+            schedule[i].offset_ms += fabs(jitter(generator));
+        }
+    }
+
+    // bursts: hold events back and release them with the last one
+    if(config.burst_len > 1) {
+        for(size_t i = 0; i < n; i++) {
+            if(!burst(generator)) {
+                continue;
+            }
+            const size_t last = min(n - 1, i + config.burst_len - 1);
+            double release = 0;
+            for(size_t j = i; j <= last; j++) {
+                release = max(release, schedule[j].offset_ms);
+            }
+            for(size_t j = i; j <= last; j++) {
+                schedule[j].offset_ms = release;
+            }
+            i = last;
+        }
+    }
+
+    // reordering: swap which event goes into two consecutive arrival slots
+    for(size_t i = 0; i + 1 < n; i++) {
+        if(reorder(generator)) {
+            swap(schedule[i].index, schedule[i + 1].index);
+            i++;
+        }
+    }
+
+    stable_sort(schedule.begin(), schedule.end(),
+        [](const Delivery& a, const Delivery& b) {
+            return a.offset_ms < b.offset_ms;
+        });
+    return schedule;
+}
+
+}  // namespace
+
+
+/**
+ * @brief get latency percentile
+ * 
+ * @param p (double) - percentile in [0, 100]
+ * 
+ * @return (double) - latency in microseconds, 0 if nothing was processed
+*/
+double ReplayStats::percentile(double p) const {
+    if(latency_us.empty()) {
+        return 0;
+    }
+    vector<double> sorted(latency_us);
+    const double rank = min(max(p, 0.0), 100.0) / 100 * (sorted.size() - 1);
+    const size_t k = static_cast<size_t>(ceil(rank));
+    nth_element(sorted.begin(), sorted.begin() + k, sorted.end());
+    return sorted[k];
+}
+
+
+/**
+ * @brief get mean latency
+ * 
+ * @return (double) - latency in microseconds, 0 if nothing was processed
+*/
+double ReplayStats::mean() const {
+    if(latency_us.empty()) {
+        return 0;
+    }
+    return accumulate(latency_us.begin(), latency_us.end(), 0.0) / latency_us.size();
+}
+
+
+/**
+ * @brief Load and merge any number of sensor logs ordered by timestamp
+ * @details Data in files should be comma seperated values. (eg time, pos)
+ * 
+ * @param filenames (vector<string>) - File paths of the logs, sensor i + 1 is filenames[i]
+ * 
+ * @return vector<SensorEvent> - merged events
+*/
+vector<SensorEvent> loadSensorLogs(const vector<string>& filenames) {
+    vector<SensorEvent> events;
+
+    for(size_t i = 0; i < filenames.size(); i++) {
+        vector<double> timestamps;
+        vector<double> pos;
+        getData(filenames[i], timestamps, pos);
+        for(size_t j = 0; j < timestamps.size(); j++) {
+            events.push_back({timestamps[j], pos[j], static_cast<int>(i) + 1});
+        }
+    }
+
+    stable_sort(events.begin(), events.end(),
+        [](const SensorEvent& a, const SensorEvent& b) {
+            return a.timestamp < b.timestamp;
+        });
+    return events;
+}
+
+
+/**
+ * @brief Constructor for ReplayHarness class
+ * 
+ * @param config (ReplayConfig) - playback and disturbance settings
+*/
+ReplayHarness::ReplayHarness(const ReplayConfig& config)
+    : config_(config)
+    {
+        if(config_.queue_capacity == 0) {
+            throw runtime_error("Replay queue capacity must be positive.");
+        }
+    }
+
+
+/**
+ * @brief play events according to their timestamps and feed a pipeline
+ * 
+ * @param events (vector<SensorEvent>) - events ordered by timestamp
+ * @param pipeline (function) - called for each event, returns once the
+ *                              estimate for it is available
+ * 
+ * @return (ReplayStats) - counters and latency samples
+*/
+ReplayStats ReplayHarness::run(const vector<SensorEvent>& events,
+    const function<void(const SensorEvent&)>& pipeline) {
+    ReplayStats stats;
+    if(events.empty()) {
+        return stats;
+    }
+
+    const vector<Delivery> schedule = buildSchedule(events, config_);
+    const bool max_speed = config_.speed <= 0;
+    stats.latency_us.reserve(events.size());
+
+    mutex lock;
+    condition_variable not_empty;
+    condition_variable not_full;
+    deque<Arrival> queue;
+    bool done = false;
+    bool stop = false;
+
+    const Clock::time_point start = Clock::now();
+
+    thread producer([&] {
+        for(const Delivery& d : schedule) {
+            {
+                lock_guard<mutex> guard(lock);
+                if(stop) {
+                    break;
+                }
+            }
+            if(!max_speed || d.offset_ms > 0) {
+                this_thread::sleep_until(start +
+                    chrono::duration_cast<Clock::duration>(
+                        chrono::duration<double, milli>(d.offset_ms)));
+            }
+
+            unique_lock<mutex> guard(lock);
+            if(queue.size() >= config_.queue_capacity) {
+                if(!max_speed) {
+                    stats.dropped++;
+                    continue;
+                }
+                // at max speed block instead of dropping, every event is processed
+                not_full.wait(guard, [&] {
+                    return queue.size() < config_.queue_capacity || stop;
+                });
+                if(stop) {
+                    break;
+                }
+            }
+            queue.push_back({d.index, Clock::now()});
+            stats.delivered++;
+            guard.unlock();
+            not_empty.notify_one();
+        }
+
+        lock_guard<mutex> guard(lock);
+        done = true;
+        not_empty.notify_one();
+    });
+
+    bool started = false;
+    double newest = 0;
+    while(true) {
+        unique_lock<mutex> guard(lock);
+        not_empty.wait(guard, [&] { return !queue.empty() || done; });
+        if(queue.empty()) {
+            break;
+        }
+        const Arrival arrival = queue.front();
+        queue.pop_front();
+        guard.unlock();
+        not_full.notify_one();
+
+        // At max speed every event arrives at once, so queueing time would
+        // only measure the backlog, time the pipeline from dequeue instead
+        const Clock::time_point received = max_speed ? Clock::now() : arrival.time;
+
+        const SensorEvent& event = events[arrival.index];
+        if(started && event.timestamp < newest) {
+            stats.late++;
+            continue;
+        }
+        started = true;
+        newest = event.timestamp;
+
+        try {
+            pipeline(event);
+        }
+        catch(...) {
+            {
+                lock_guard<mutex> stop_guard(lock);
+                stop = true;
+            }
+            not_full.notify_one();
+            producer.join();
+            throw;
+        }
+
+        const double latency = chrono::duration<double, micro>(
+            Clock::now() - received).count();
+        stats.latency_us.push_back(latency);
+        stats.processed++;
+        if(config_.deadline_ms > 0 && latency > config_.deadline_ms * 1000) {
+            stats.deadline_misses++;
+        }
+    }
+
+    producer.join();
+    stats.wall_time_s = chrono::duration<double>(Clock::now() - start).count();
+    return stats;
+}
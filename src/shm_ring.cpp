@@ -0,0 +1,453 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @file shm_ring.cpp
+ * @author Rishabh Mukund (rishabh.m96@gmail.com)
+ * @brief Seqlocked POSIX shared memory ring for publishing filter estimates
+ * @version 1.0
+ * @date 18/10/2026
+ *
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+*/
+
+#include "shm_ring.hpp"
+
+#include<cerrno>
+#include<cstring>
+#include<fcntl.h>
+#include<signal.h>
+#include<stdexcept>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<unistd.h>
+
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Fixed part of a slot, the record values follow it
+*/
+struct SlotHeader {
+    atomic<uint64_t> seq;   // 2k + 1 while record k is written, 2k + 2 once done
+    double timestamp;
+    uint64_t track_id;
+};
+
+constexpr size_t kSlotAlign = 64;
+
+
+string systemError(const string& what, const string& name) {
+    return what + " " + name + ": " + strerror(errno);
+}
+
+
+/**
+ * @brief get the publisher of the existing shared memory object name
+ * 
+ * @return (pid_t) - process id of a running publisher, 0 if the object is
+ *                   a ring whose publisher has exited, -1 if it is not a
+ *                   complete ring (foreign object or still being created)
+*/
+pid_t ringOwner(const string& name) {
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if(fd < 0) {
+        return errno == ENOENT ? 0 : -1;
+    }
+    struct stat info;
+    if(fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(ShmRingHeader)) {
+        close(fd);
+        return -1;
+    }
+    void* base = mmap(nullptr, sizeof(ShmRingHeader), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if(base == MAP_FAILED) {
+        return -1;
+    }
+
+    const ShmRingHeader* header = static_cast<const ShmRingHeader*>(base);
+    const bool valid = header->magic == kShmRingMagic;
+    atomic_thread_fence(memory_order_acquire);
+    pid_t owner = -1;
+    if(valid && header->version != kShmRingVersion) {
+        owner = 0;  // left by an older build, its publisher is gone
+    }
+    else if(valid) {
+        owner = static_cast<pid_t>(header->writer_pid);
+        if(owner <= 0 || (kill(owner, 0) != 0 && errno == ESRCH)) {
+            owner = 0;
+        }
+    }
+    munmap(base, sizeof(ShmRingHeader));
+    return owner;
+}
+
+}  // namespace
+
+
+/**
+ * @brief Constructor for ShmPublisher class
+ * 
+ * @param name (string) - shared memory object name, starting with '/'
+ * @param slot_count (int) - number of records kept for readers
+ * @param state_dim (int) - number of state parameters per record
+ * @param with_covariance (bool) - publish the covariance matrix as well
+*/
+ShmPublisher::ShmPublisher(const string& name, int slot_count, int state_dim,
+    bool with_covariance)
+    : name_(name),
+      bytes_(0),
+      header_(nullptr),
+      slots_(nullptr),
+      next_(0)
+    {
+        if(slot_count <= 0 || state_dim <= 0) {
+            throw runtime_error("Shared memory ring needs at least one slot and one state.");
+        }
+
+        size_t values = state_dim + (with_covariance ? state_dim * state_dim : 0);
+        size_t slot_size = sizeof(SlotHeader) + values * sizeof(double);
+        slot_size = (slot_size + kSlotAlign - 1) / kSlotAlign * kSlotAlign;
+        bytes_ = sizeof(ShmRingHeader) + slot_count * slot_size;
+
+        int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if(fd < 0 && errno == EEXIST) {
+            const pid_t owner = ringOwner(name_);
+            if(owner != 0) {
+                throw runtime_error("Shared memory " + name_ + " is already in use" +
+                    (owner > 0 ? " by process " + to_string(owner) : string()) + ".");
+            }
+            // Replace a ring left behind by a publisher that did not exit cleanly
+            shm_unlink(name_.c_str());
+            fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        }
+        if(fd < 0) {
+            throw runtime_error(systemError("Failed to create shared memory", name_));
+        }
+        if(ftruncate(fd, bytes_) != 0) {
+            string error = systemError("Failed to size shared memory", name_);
+            close(fd);
+            shm_unlink(name_.c_str());
+            throw runtime_error(error);
+        }
+        void* base = mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if(base == MAP_FAILED) {
+            string error = systemError("Failed to map shared memory", name_);
+            shm_unlink(name_.c_str());
+            throw runtime_error(error);
+        }
+
+        // ftruncate zero fills, so every slot starts out with seq 0 (empty)
+        header_ = static_cast<ShmRingHeader*>(base);
+        slots_ = static_cast<unsigned char*>(base) + sizeof(ShmRingHeader);
+        header_->version = kShmRingVersion;
+        header_->slot_count = slot_count;
+        header_->state_dim = state_dim;
+        header_->has_covariance = with_covariance ? 1 : 0;
+        header_->slot_size = slot_size;
+        header_->writer_pid = getpid();
+        header_->write_index.store(0, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+        header_->magic = kShmRingMagic;
+    }
+
+
+ShmPublisher::~ShmPublisher() {
+    munmap(header_, bytes_);
+    shm_unlink(name_.c_str());
+}
+
+
+/**
+ * @brief publish one estimate
+ * 
+ * @param timestamp (double) - time stamp of the estimate
+ * @param track_id (uint64_t) - track the estimate belongs to
+ * @param x (double*) - state_dim state values
+ * @param P (double*) - state_dim * state_dim column-major covariance,
+ *                      required if the ring has covariance, else ignored
+*/
+void ShmPublisher::publish(double timestamp, uint64_t track_id, const double* x,
+    const double* P) {
+    if(header_->has_covariance && P == nullptr) {
+        throw runtime_error("Shared memory ring expects a covariance with every estimate.");
+    }
+
+    const size_t n = header_->state_dim;
+    unsigned char* slot = slots_ + (next_ % header_->slot_count) * header_->slot_size;
+    SlotHeader* head = reinterpret_cast<SlotHeader*>(slot);
+    double* values = reinterpret_cast<double*>(slot + sizeof(SlotHeader));
+
+    // Odd seq marks the slot as being written, the fence keeps the
+    // record stores from moving above it
+    head->seq.store(2 * next_ + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    head->timestamp = timestamp;
+    head->track_id = track_id;
+    memcpy(values, x, n * sizeof(double));
+    if(header_->has_covariance) {
+        memcpy(values + n, P, n * n * sizeof(double));
+    }
+
+    head->seq.store(2 * next_ + 2, memory_order_release);
+    header_->write_index.store(++next_, memory_order_release);
+}
+
+
+/**
+ * @brief publish one estimate
+ * 
+ * @param timestamp (double) - time stamp of the estimate
+ * @param track_id (uint64_t) - track the estimate belongs to
+ * @param x (VectorXd) - state estimate
+ * @param P (MatrixXd) - covariance estimate
+*/
+void ShmPublisher::publish(double timestamp, uint64_t track_id, const VectorXd& x,
+    const MatrixXd& P) {
+    if(x.size() != header_->state_dim ||
+       (header_->has_covariance && (P.rows() != x.size() || P.cols() != x.size()))) {
+        throw runtime_error("Estimate size does not match the shared memory ring.");
+    }
+    publish(timestamp, track_id, x.data(), P.data());
+}
+
+
+/**
+ * @brief get number of records published so far
+ * 
+ * @return (uint64_t) - number of records
+*/
+uint64_t ShmPublisher::published() const {
+    return next_;
+}
+
+
+/**
+ * @brief Constructor for ShmReader class
+ * 
+ * @param name (string) - shared memory object name, starting with '/'
+ * @param from_oldest (bool) - start at the oldest record in the ring
+ *                             instead of the next one published
+*/
+ShmReader::ShmReader(const string& name, bool from_oldest)
+    : bytes_(0),
+      header_(nullptr),
+      slots_(nullptr),
+      cursor_(0),
+      overruns_(0)
+    {
+        int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if(fd < 0) {
+            throw runtime_error(systemError("Failed to open shared memory", name));
+        }
+        struct stat info;
+        if(fstat(fd, &info) != 0) {
+            string error = systemError("Failed to stat shared memory", name);
+            close(fd);
+            throw runtime_error(error);
+        }
+        bytes_ = info.st_size;
+        if(bytes_ < sizeof(ShmRingHeader)) {
+            close(fd);
+            throw runtime_error("Shared memory " + name + " is not an estimate ring.");
+        }
+        void* base = mmap(nullptr, bytes_, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if(base == MAP_FAILED) {
+            throw runtime_error(systemError("Failed to map shared memory", name));
+        }
+
+        header_ = static_cast<const ShmRingHeader*>(base);
+        slots_ = static_cast<const unsigned char*>(base) + sizeof(ShmRingHeader);
+        const bool valid = header_->magic == kShmRingMagic;
+        atomic_thread_fence(memory_order_acquire);
+        if(!valid || header_->version != kShmRingVersion ||
+           bytes_ != sizeof(ShmRingHeader) + header_->slot_count * header_->slot_size) {
+            munmap(const_cast<ShmRingHeader*>(header_), bytes_);
+            throw runtime_error("Shared memory " + name + " is not an estimate ring.");
+        }
+
+        cursor_ = published();
+        if(from_oldest) {
+            cursor_ = cursor_ > header_->slot_count ? cursor_ - header_->slot_count : 0;
+        }
+    }
+
+
+ShmReader::~ShmReader() {
+    munmap(const_cast<ShmRingHeader*>(header_), bytes_);
+}
+
+
+/**
+ * @brief get number of state parameters per record
+ * 
+ * @return (int) - state dimension
+*/
+int ShmReader::stateDim() const {
+    return header_->state_dim;
+}
+
+
+/**
+ * @brief check if records carry the covariance matrix
+ * 
+ * @return (bool) - true if covariance is published
+*/
+bool ShmReader::hasCovariance() const {
+    return header_->has_covariance != 0;
+}
+
+
+/**
+ * @brief get number of records published so far
+ * 
+ * @return (uint64_t) - number of records
+*/
+uint64_t ShmReader::published() const {
+    return header_->write_index.load(memory_order_acquire);
+}
+
+
+/**
+ * @brief get number of records skipped because the reader fell behind
+ * 
+ * @return (uint64_t) - number of records
+*/
+uint64_t ShmReader::overruns() const {
+    return overruns_;
+}
+
+
+/**
+ * @brief copy record index out of its slot
+ * 
+ * @param index (uint64_t) - position of the record in the stream
+ * @param record (EstimateRecord) - receives the record
+ * 
+ * @return (int) - 0 on success, -1 if the record is not published yet,
+ *                 1 if it was already overwritten, 2 if the publisher is
+ *                 writing it right now
+*/
+int ShmReader::readSlot(uint64_t index, EstimateRecord& record) const {
+    const int n = header_->state_dim;
+    const unsigned char* slot = slots_ + (index % header_->slot_count) * header_->slot_size;
+    const SlotHeader* head = reinterpret_cast<const SlotHeader*>(slot);
+    const double* values = reinterpret_cast<const double*>(slot + sizeof(SlotHeader));
+    const uint64_t done = 2 * index + 2;
+
+    record.state.resize(n);
+    record.covariance.resize(hasCovariance() ? n : 0, hasCovariance() ? n : 0);
+
+    // A publisher that died while copying the record in leaves seq odd for
+    // good, so report it to the caller instead of waiting for it
+    const uint64_t before = head->seq.load(memory_order_acquire);
+    if(before > done) {
+        return 1;
+    }
+    if(before < done - 1) {
+        return -1;
+    }
+    if(before == done - 1) {
+        return 2;
+    }
+
+    record.timestamp = head->timestamp;
+    record.track_id = head->track_id;
+    memcpy(record.state.data(), values, n * sizeof(double));
+    if(hasCovariance()) {
+        memcpy(record.covariance.data(), values + n, n * n * sizeof(double));
+    }
+
+    // Keep the copies above from moving below the second seq load
+    atomic_thread_fence(memory_order_acquire);
+    if(head->seq.load(memory_order_relaxed) != before) {
+        return 1;
+    }
+    record.index = index;
+    return 0;
+}
+
+
+/**
+ * @brief copy out the most recently published record
+ * 
+ * @param record (EstimateRecord) - receives the record
+ * 
+ * @return (bool) - false if nothing was published yet, or the only
+ *                  published record is being written
+*/
+bool ShmReader::latest(EstimateRecord& record) const {
+    while(true) {
+        const uint64_t count = published();
+        if(count == 0) {
+            return false;
+        }
+        const int status = readSlot(count - 1, record);
+        if(status == 0) {
+            return true;
+        }
+        if(status == 2) {
+            // Still being written, fall back to the record before it
+            return count >= 2 && readSlot(count - 2, record) == 0;
+        }
+        // Overwritten while copying, the publisher has moved on, try again
+    }
+}
+
+
+/**
+ * @brief copy out the next record after the previous call
+ * 
+ * @param record (EstimateRecord) - receives the record
+ * 
+ * @return (bool) - false if no new record was published, or the
+ *                  publisher is writing it right now (poll again)
+*/
+bool ShmReader::next(EstimateRecord& record) {
+    while(true) {
+        const uint64_t count = published();
+        if(cursor_ >= count) {
+            return false;
+        }
+        if(count - cursor_ > header_->slot_count) {
+            overruns_ += count - header_->slot_count - cursor_;
+            cursor_ = count - header_->slot_count;
+        }
+        const int status = readSlot(cursor_, record);
+        if(status == 0) {
+            cursor_++;
+            return true;
+        }
+        if(status == 2) {
+            return false;  // being written, the caller polls again
+        }
+        if(status > 0) {
+            overruns_++;
+            cursor_++;
+        }
+    }
+}
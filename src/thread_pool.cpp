@@ -0,0 +1,173 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @file thread_pool.cpp
+ * @author Rishabh Mukund (rishabh.m96@gmail.com)
+ * @brief Fixed size thread pool with a blocking parallel for
+ * @version 1.0
+ * @date 18/10/2026
+ *
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+*/
+
+#include "thread_pool.hpp"
+
+#include<algorithm>
+
+
+using namespace std;
+
+/**
+ * @brief Constructor for ThreadPool class
+ * 
+ * @param num_threads (int) - Number of threads including the caller,
+ *                            0 uses the hardware concurrency
+*/
+ThreadPool::ThreadPool(int num_threads)
+    : body_(nullptr),
+      end_(0),
+      chunk_(1),
+      next_(0),
+      generation_(0),
+      pending_(0),
+      stop_(false)
+    {
+        if(num_threads <= 0) {
+            num_threads = max(1u, thread::hardware_concurrency());
+        }
+        for(int i = 1; i < num_threads; i++) {
+            workers_.emplace_back(&ThreadPool::workerLoop, this);
+        }
+    }
+
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> guard(lock_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for(thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+
+/**
+ * @brief get number of threads running jobs, including the caller
+ * 
+ * @return (int) - number of threads
+*/
+int ThreadPool::size() const {
+    return static_cast<int>(workers_.size()) + 1;
+}
+
+
+/**
+ * @brief claim and run chunks of the current job until none are left
+*/
+void ThreadPool::runChunks() {
+    while(true) {
+        const size_t first = next_.fetch_add(chunk_);
+        if(first >= end_) {
+            break;
+        }
+        try {
+            (*body_)(first, min(first + chunk_, end_));
+        }
+        catch(...) {
+            lock_guard<mutex> guard(lock_);
+            if(!error_) {
+                error_ = current_exception();
+            }
+            // skip the remaining chunks
+            next_.store(end_);
+        }
+    }
+}
+
+
+void ThreadPool::workerLoop() {
+    uint64_t seen = 0;
+    while(true) {
+        {
+            unique_lock<mutex> guard(lock_);
+            wake_.wait(guard, [&] { return stop_ || generation_ != seen; });
+            if(stop_) {
+                return;
+            }
+            seen = generation_;
+        }
+
+        runChunks();
+
+        lock_guard<mutex> guard(lock_);
+        if(--pending_ == 0) {
+            done_.notify_one();
+        }
+    }
+}
+
+
+/**
+ * @brief run body over [begin, end) split in chunks across the pool
+ * 
+ * @param begin (size_t) - first index
+ * @param end (size_t) - one past the last index
+ * @param body (function) - called with sub ranges [first, last)
+*/
+void ThreadPool::parallelFor(size_t begin, size_t end,
+    const function<void(size_t, size_t)>& body) {
+    if(begin >= end) {
+        return;
+    }
+    const size_t count = end - begin;
+    if(workers_.empty() || count == 1) {
+        body(begin, end);
+        return;
+    }
+
+    {
+        lock_guard<mutex> guard(lock_);
+        body_ = &body;
+        end_ = end;
+        // a few chunks per thread to even out uneven work
+        chunk_ = max<size_t>(1, count / (4 * size()));
+        next_.store(begin);
+        error_ = nullptr;
+        pending_ = static_cast<int>(workers_.size());
+        generation_++;
+    }
+    wake_.notify_all();
+
+    runChunks();
+
+    unique_lock<mutex> guard(lock_);
+    done_.wait(guard, [&] { return pending_ == 0; });
+    body_ = nullptr;
+    if(error_) {
+        exception_ptr error = error_;
+        error_ = nullptr;
+        rethrow_exception(error);
+    }
+}
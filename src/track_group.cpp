@@ -0,0 +1,242 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @file track_group.cpp
+ * @author Rishabh Mukund (rishabh.m96@gmail.com)
+ * @brief Group of tracks sharing one covariance and gain sequence
+ * @version 1.0
+ * @date 18/10/2026
+ *
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+*/
+
+#include "track_group.hpp"
+#include "cpu_dispatch.hpp"
+
+#include<algorithm>
+#include<stdexcept>
+
+
+using namespace Eigen;
+using namespace std;
+
+/**
+ * @brief Constructor for SharedCovarianceGroup class
+ * 
+ * @param num_states (int) - Number of state parameters
+ * @param num_measurements (int) - Number of independent measurements
+*/
+SharedCovarianceGroup::SharedCovarianceGroup(int num_states, int num_measurements)
+    : num_states_(num_states),
+      num_measurements_(num_measurements),
+      num_tracks_(0),
+      H_(num_measurements, num_states),
+      Q_(num_states, num_states),
+      Pp_(num_states, num_states),
+      Pe_(MatrixXd::Zero(num_states, num_states)),
+      K_(MatrixXd::Zero(num_states, num_measurements)),
+      xz_(VectorXd::Zero(num_states)),
+      xd_(num_states),
+      yz_(VectorXd::Zero(num_measurements)),
+      work_(max(num_states * num_states,
+                2 * num_states * num_measurements +
+                2 * num_measurements * num_measurements + num_measurements)),
+      started_(false)
+    {
+    }
+
+
+/**
+ * @brief set obervation matrix (H) of system
+ * 
+ * @param H (MatrixXd) - Obervation matrix 
+*/
+void SharedCovarianceGroup::setObervationMatrix(const MatrixXd& H) {
+    if(H.rows() != num_measurements_ || H.cols() != num_states_) {
+        throw runtime_error("Invalid dimension for obeservation matrix.");
+    }
+    H_ = H;
+}
+
+
+/**
+ * @brief set noise covariance matrix (Q) of system
+ * 
+ * @param Q (MatrixXd) - Noise covariance matrix
+*/
+void SharedCovarianceGroup::setNoiseCovariance(const MatrixXd& Q) {
+    if(Q.rows() != num_states_ || Q.cols() != num_states_) {
+        throw runtime_error("Invalid dimension for noise covariance matrix.");
+    }
+    Q_ = Q;
+}
+
+
+/**
+ * @brief set initial Process Covariance Matrix shared by all tracks
+ * 
+ * @param Pi (MatrixXd) - Initial Process Covariance Matrix
+*/
+void SharedCovarianceGroup::setInitCovariance(const MatrixXd& Pi) {
+    if(Pi.rows() != num_states_ || Pi.cols() != num_states_) {
+        throw runtime_error("Invalid dimensions for system state.");
+    }
+    if(started_) {
+        throw runtime_error("Covariance of a running group cannot be reset.");
+    }
+    Pe_ = Pi;
+}
+
+
+/**
+ * @brief add a track to the group, only before the first step
+ * 
+ * @param xi (VectorXd) - Initial state vector
+ * 
+ * @return (int) - index of the track in the group
+*/
+int SharedCovarianceGroup::addTrack(const VectorXd& xi) {
+    if(xi.size() != num_states_) {
+        throw runtime_error("Invalid dimensions for system state.");
+    }
+    if(started_) {
+        throw runtime_error("Tracks can only join a group before its first step.");
+    }
+
+    // re-pack lane-major with one more lane
+    const int count = num_tracks_ + 1;
+    vector<double> x(num_states_ * count);
+    for(int i = 0; i < num_states_; i++) {
+        for(int t = 0; t < num_tracks_; t++) {
+            x[i * count + t] = x_[i * num_tracks_ + t];
+        }
+        x[i * count + num_tracks_] = xi(i);
+    }
+    x_.swap(x);
+    return num_tracks_++;
+}
+
+
+void SharedCovarianceGroup::predictCovariance(const MatrixXd& A) {
+    if(A.rows() != num_states_ || A.cols() != num_states_) {
+        throw runtime_error("Invalid dimensions for state matrices.");
+    }
+    if(!started_) {
+        xwork_.resize((num_states_ + num_measurements_) * num_tracks_);
+        started_ = true;
+    }
+
+    // Pp = A * Pe * A' + Q, once for the whole group
+    kernels().predict(num_states_, A.data(), xz_.data(), 0, Q_.data(),
+        xz_.data(), Pe_.data(), xd_.data(), Pp_.data(), work_.data());
+}
+
+
+/**
+ * @brief run predict and update for every track
+ * 
+ * @param A (MatrixXd) - State transition matrix
+ * @param y (vector<double>) - Measured state variables of all tracks
+ * @param R (MatrixXd) - Observation noise covariance matrix
+*/
+void SharedCovarianceGroup::step(const MatrixXd& A, const vector<double>& y,
+    const MatrixXd& R) {
+    if(R.rows() != num_measurements_ || R.cols() != num_measurements_ ||
+       y.size() != static_cast<size_t>(num_measurements_) * num_tracks_) {
+        throw runtime_error("Invalid dimension for Observation noise covariance matrix.");
+    }
+    predictCovariance(A);
+
+    // K and Pe once for the whole group, the state output is discarded
+    if(kernels().update(num_states_, num_measurements_, H_.data(), R.data(),
+           yz_.data(), xz_.data(), Pp_.data(), xd_.data(), Pe_.data(),
+           K_.data(), work_.data()) != 0) {
+        throw runtime_error("Singular innovation covariance in update step.");
+    }
+
+    kernels().propagateShared(num_states_, num_measurements_, num_tracks_,
+        A.data(), K_.data(), H_.data(), y.data(), x_.data(), xwork_.data());
+}
+
+
+/**
+ * @brief run predict only (no measurement at this time) for every track
+ * 
+ * @param A (MatrixXd) - State transition matrix
+*/
+void SharedCovarianceGroup::predict(const MatrixXd& A) {
+    predictCovariance(A);
+    Pe_ = Pp_;
+
+    kernels().propagateShared(num_states_, num_measurements_, num_tracks_,
+        A.data(), K_.data(), H_.data(), nullptr, x_.data(), xwork_.data());
+}
+
+
+/**
+ * @brief get number of tracks in the group
+ * 
+ * @return (int) - number of tracks
+*/
+int SharedCovarianceGroup::size() const {
+    return num_tracks_;
+}
+
+
+/**
+ * @brief get Estimated state vector of a track
+ * 
+ * @param track (int) - index of the track
+ * 
+ * @return (VectorXd) - Estimated state vector
+*/
+VectorXd SharedCovarianceGroup::getStateEstimate(int track) const {
+    if(track < 0 || track >= num_tracks_) {
+        throw runtime_error("Invalid track index.");
+    }
+    VectorXd x(num_states_);
+    for(int i = 0; i < num_states_; i++) {
+        x(i) = x_[i * num_tracks_ + track];
+    }
+    return x;
+}
+
+
+/**
+ * @brief get Estimated Process Covariance Matrix shared by all tracks
+ * 
+ * @return (MatrixXd) - Estimated Process Covariance Matrix
+*/
+const MatrixXd& SharedCovarianceGroup::getCovarianceEstimate() const {
+    return Pe_;
+}
+
+
+/**
+ * @brief get Kalman Gain Matrix of the last update
+ * 
+ * @return (MatrixXd) - Kalman Gain Matrix
+*/
+const MatrixXd& SharedCovarianceGroup::getGain() const {
+    return K_;
+}
@@ -0,0 +1,348 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @file track_pool.cpp
+ * @author Rishabh Mukund (rishabh.m96@gmail.com)
+ * @brief Preallocated track store with generation counted handles
+ * @version 1.0
+ * @date 18/10/2026
+ *
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+*/
+
+#include "track_pool.hpp"
+#include "cpu_dispatch.hpp"
+
+#include<algorithm>
+#include<cstring>
+#include<stdexcept>
+
+
+using namespace Eigen;
+using namespace std;
+
+namespace {
+
+const uint32_t kNoSlot = 0xffffffffu;  // end of the free list
+
+}  // namespace
+
+
+/**
+ * @brief Constructor for TrackPool class
+ * 
+ * @param num_states (int) - Number of state parameters
+ * @param num_measurements (int) - Number of independent measurements
+ * @param capacity (int) - Maximum number of live tracks
+*/
+TrackPool::TrackPool(int num_states, int num_measurements, int capacity)
+    : num_states_(num_states),
+      num_measurements_(num_measurements),
+      capacity_(capacity),
+      // xe, Pe, xp, Pp, K rounded up to whole 64 byte cache lines
+      stride_((2 * num_states + 2 * num_states * num_states +
+               num_states * num_measurements + 7) / 8 * 8),
+      size_(0),
+      H_(ObservationModel::dense(MatrixXd::Zero(num_measurements, num_states))),
+      Q_(MatrixXd::Zero(num_states, num_states)),
+      arena_(static_cast<size_t>(stride_) * max(capacity, 0), 0.0),
+      generation_(max(capacity, 0), 1),
+      dense_of_(max(capacity, 0), 0),
+      slot_of_(max(capacity, 0), 0),
+      next_free_(max(capacity, 0), kNoSlot),
+      free_head_(capacity > 0 ? 0 : kNoSlot),
+      work_(max(num_states * num_states,
+                2 * num_states * num_measurements +
+                2 * num_measurements * num_measurements + num_measurements))
+    {
+        if(capacity <= 0) {
+            throw runtime_error("Track pool capacity must be positive.");
+        }
+        for(int i = 0; i + 1 < capacity; i++) {
+            next_free_[i] = i + 1;
+        }
+    }
+
+
+double* TrackPool::block(int index) {
+    return arena_.data() + static_cast<size_t>(index) * stride_;
+}
+
+
+const double* TrackPool::block(int index) const {
+    return arena_.data() + static_cast<size_t>(index) * stride_;
+}
+
+
+/**
+ * @brief get block index of a live track, throws for stale handles
+*/
+int TrackPool::indexOf(TrackHandle track) const {
+    if(!valid(track)) {
+        throw runtime_error("Invalid or stale track handle.");
+    }
+    return static_cast<int>(dense_of_[track.slot]);
+}
+
+
+/**
+ * @brief set obervation matrix (H) of all tracks
+ * 
+ * @param H (MatrixXd) - Obervation matrix 
+*/
+void TrackPool::setObervationMatrix(const MatrixXd& H) {
+    setObervationMatrix(ObservationModel::fromMatrix(H));
+}
+
+
+/**
+ * @brief set typed obervation model (H) of all tracks
+ * 
+ * @param H (ObservationModel) - Obervation model
+*/
+void TrackPool::setObervationMatrix(const ObservationModel& H) {
+    if(H.matrix().rows() != num_measurements_ || H.matrix().cols() != num_states_) {
+        throw runtime_error("Invalid dimension for obeservation matrix.");
+    }
+    H_ = H;
+}
+
+
+/**
+ * @brief set noise covariance matrix (Q) of all tracks
+ * 
+ * @param Q (MatrixXd) - Noise covariance matrix
+*/
+void TrackPool::setNoiseCovariance(const MatrixXd& Q) {
+    if(Q.rows() != num_states_ || Q.cols() != num_states_) {
+        throw runtime_error("Invalid dimension for noise covariance matrix.");
+    }
+    Q_ = Q;
+}
+
+
+/**
+ * @brief create a track in a free slot
+ * 
+ * @param xi (VectorXd) - Initial state vector
+ * @param Pi (MatrixXd) - Initial Process Covariance Matrix
+ * 
+ * @return (TrackHandle) - handle of the new track
+*/
+TrackHandle TrackPool::create(const VectorXd& xi, const MatrixXd& Pi) {
+    if(xi.size() != num_states_ || Pi.rows() != num_states_ ||
+       Pi.cols() != num_states_ ) {
+        throw runtime_error("Invalid dimensions for system state.");
+    }
+    if(free_head_ == kNoSlot) {
+        throw runtime_error("Track pool is full.");
+    }
+
+    const uint32_t slot = free_head_;
+    free_head_ = next_free_[slot];
+    next_free_[slot] = kNoSlot;
+
+    const int index = size_++;
+    dense_of_[slot] = index;
+    slot_of_[index] = slot;
+
+    const int n = num_states_;
+    double* b = block(index);
+    memcpy(b, xi.data(), n * sizeof(double));
+    memcpy(b + n, Pi.data(), n * n * sizeof(double));
+    memcpy(b + n + n*n, xi.data(), n * sizeof(double));
+    memcpy(b + 2*n + n*n, Pi.data(), n * n * sizeof(double));
+    fill(b + 2*n + 2*n*n, b + stride_, 0.0);
+
+    return {slot, generation_[slot]};
+}
+
+
+/**
+ * @brief destroy a track and recycle its slot
+ * 
+ * @param track (TrackHandle) - handle of a live track
+*/
+void TrackPool::destroy(TrackHandle track) {
+    const int index = indexOf(track);
+    const int last = --size_;
+
+    // keep live tracks compacted, move the last one into the hole
+    if(index != last) {
+        memcpy(block(index), block(last), stride_ * sizeof(double));
+        const uint32_t moved = slot_of_[last];
+        slot_of_[index] = moved;
+        dense_of_[moved] = index;
+    }
+
+    // a new generation makes every copy of the old handle stale
+    if(++generation_[track.slot] == 0) {
+        generation_[track.slot] = 1;
+    }
+    next_free_[track.slot] = free_head_;
+    free_head_ = track.slot;
+}
+
+
+/**
+ * @brief check if a handle refers to a live track
+ * 
+ * @param track (TrackHandle) - handle to check
+ * 
+ * @return (bool) - true if the track is alive
+*/
+bool TrackPool::valid(TrackHandle track) const {
+    return track.slot < generation_.size() &&
+           track.generation != 0 &&
+           generation_[track.slot] == track.generation &&
+           dense_of_[track.slot] < static_cast<uint32_t>(size_) &&
+           slot_of_[dense_of_[track.slot]] == track.slot;
+}
+
+
+/**
+ * @brief run predict step of one track
+ * 
+ * @param track (TrackHandle) - handle of a live track
+ * @param A (MatrixXd) - State transition matrix
+ * @param B (MatrixXd) - Control input matrix
+ * @param u (VectorXd) - Control vector
+*/
+void TrackPool::predict(TrackHandle track, const MatrixXd& A, const MatrixXd& B,
+    const VectorXd& u) {
+    if(A.rows() != num_states_ || A.cols() != num_states_ ||
+       B.rows() != num_states_ || B.cols() != 1 || u.size() != 1) {
+        throw runtime_error("Invalid dimensions for state matrices.");
+    }
+
+    const int n = num_states_;
+    double* b = block(indexOf(track));
+    kernels().predict(n, A.data(), B.data(), u(0), Q_.data(), b, b + n,
+        b + n + n*n, b + 2*n + n*n, work_.data());
+}
+
+
+/**
+ * @brief run predict step of every live track, in memory order
+ * 
+ * @param A (MatrixXd) - State transition matrix
+ * @param B (MatrixXd) - Control input matrix
+ * @param u (VectorXd) - Control vector
+*/
+void TrackPool::predictAll(const MatrixXd& A, const MatrixXd& B, const VectorXd& u) {
+    if(A.rows() != num_states_ || A.cols() != num_states_ ||
+       B.rows() != num_states_ || B.cols() != 1 || u.size() != 1) {
+        throw runtime_error("Invalid dimensions for state matrices.");
+    }
+
+    const int n = num_states_;
+    const KernelTable& k = kernels();
+    for(int i = 0; i < size_; i++) {
+        double* b = block(i);
+        k.predict(n, A.data(), B.data(), u(0), Q_.data(), b, b + n,
+            b + n + n*n, b + 2*n + n*n, work_.data());
+    }
+}
+
+
+/**
+ * @brief run update step of one track
+ * 
+ * @param track (TrackHandle) - handle of a live track
+ * @param y (VectorXd) - Measured state variables
+ * @param R (MatrixXd) - Observation noise covariance matrix  
+*/
+void TrackPool::update(TrackHandle track, const VectorXd& y, const MatrixXd& R) {
+    if(R.rows() != num_measurements_ || R.cols() != num_measurements_ ||
+       y.size() != num_measurements_) {
+        throw runtime_error("Invalid dimension for Observation noise covariance matrix.");
+    }
+
+    const int n = num_states_;
+    double* b = block(indexOf(track));
+    if(H_.update(kernels(), R.data(), y.data(), b + n + n*n, b + 2*n + n*n,
+           b, b + n, b + 2*n + 2*n*n, work_.data()) != 0) {
+        throw runtime_error("Singular innovation covariance in update step.");
+    }
+}
+
+
+/**
+ * @brief get Estimated state vector of a track, valid until the pool changes
+ * 
+ * @param track (TrackHandle) - handle of a live track
+ * 
+ * @return (Map<const VectorXd>) - Estimated state vector
+*/
+Map<const VectorXd> TrackPool::getStateEstimate(TrackHandle track) const {
+    return Map<const VectorXd>(block(indexOf(track)), num_states_);
+}
+
+
+/**
+ * @brief get Predicited state vector of a track, valid until the pool changes
+ * 
+ * @param track (TrackHandle) - handle of a live track
+ * 
+ * @return (Map<const VectorXd>) - Predicited state vector
+*/
+Map<const VectorXd> TrackPool::getStatePredicited(TrackHandle track) const {
+    const int n = num_states_;
+    return Map<const VectorXd>(block(indexOf(track)) + n + n*n, n);
+}
+
+
+/**
+ * @brief get handle of the i-th live track, for iterating over the pool
+ * 
+ * @param index (int) - index in [0, size())
+ * 
+ * @return (TrackHandle) - handle of the track
+*/
+TrackHandle TrackPool::handleAt(int index) const {
+    if(index < 0 || index >= size_) {
+        throw runtime_error("Invalid track index.");
+    }
+    const uint32_t slot = slot_of_[index];
+    return {slot, generation_[slot]};
+}
+
+
+/**
+ * @brief get number of live tracks
+ * 
+ * @return (int) - number of live tracks
+*/
+int TrackPool::size() const {
+    return size_;
+}
+
+
+/**
+ * @brief get maximum number of live tracks
+ * 
+ * @return (int) - capacity of the pool
+*/
+int TrackPool::capacity() const {
+    return capacity_;
+}
@@ -0,0 +1,325 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @file kf_bench.cpp
+ * @author Rishabh Mukund (rishabh.m96@gmail.com)
+ * @brief Benchmark of the scalar and batched predict/update kernels
+ * @version 1.0
+ * @date 18/10/2026
+ *
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+*/
+
+#include "kalman_filter.hpp"
+#include "cpu_dispatch.hpp"
+#include "track_group.hpp"
+#include "imm_filter.hpp"
+
+#include<Eigen/Dense>
+#include<chrono>
+#include<cstdlib>
+#include<cstring>
+#include<iostream>
+#include<string>
+#include<vector>
+
+
+using namespace std;
+using namespace Eigen;
+
+namespace {
+
+struct BenchConfig {
+    int num_states = 2;     // state size of every filter
+    int steps = 200000;     // predict/update steps per filter
+    int tracks = 1024;      // lanes in the batched benchmark
+    int batch_steps = 500;  // steps of the batched benchmark
+    bool all_isa = false;   // run every supported ISA level
+    bool dense_h = false;   // force the dense update instead of the selection one
+};
+
+
+void printUsage() {
+    cout << "usage: KalmanFilterBench [--isa=<baseline|sse4.2|avx2|avx512>] [--all-isa]\n"
+         << "                         [--states N] [--steps N] [--tracks N] [--batch-steps N]\n"
+         << "                         [--dense-h]\n"
+         << "ISA level can also be forced with the KF_ISA environment variable.\n";
+}
+
+
+/**
+ * @brief constant velocity transition of size n (position, velocity, ...)
+*/
+MatrixXd transition(int n, double dt) {
+    MatrixXd A = MatrixXd::Identity(n, n);
+    for(int i = 0; i + 1 < n; i++) {
+        A(i, i + 1) = dt;
+    }
+    return A;
+}
+
+
+/**
+ * @brief time predict + update of a single KalmanFilter
+ * 
+ * @return (double) - nanoseconds per step
+*/
+double benchScalar(const BenchConfig& cfg, double& checksum) {
+    const int n = cfg.num_states;
+    MatrixXd A = transition(n, 0.05);
+    MatrixXd B = MatrixXd::Zero(n, 1);
+    MatrixXd H = MatrixXd::Zero(1, n);
+    MatrixXd R(1, 1);
+    VectorXd u = VectorXd::Zero(1);
+    VectorXd y(1);
+    H(0, 0) = 1;
+    R << 1;
+
+    KalmanFilter kf(n, 1);
+    if(cfg.dense_h) {
+        kf.setObervationMatrix(ObservationModel::dense(H));
+    }
+    else {
+        kf.setObervationMatrix(H);
+    }
+    kf.setInitState(VectorXd::Zero(n), MatrixXd::Identity(n, n));
+    kf.setNoiseCovariance(MatrixXd::Identity(n, n) * 0.1);
+
+    auto start = chrono::steady_clock::now();
+    for(int i = 0; i < cfg.steps; i++) {
+        kf.predict(A, B, u);
+        y << 0.001 * i;
+        kf.update(y, R);
+    }
+    auto stop = chrono::steady_clock::now();
+
+    checksum += kf.getStateEstimate()[0];
+    return chrono::duration<double, nano>(stop - start).count() / cfg.steps;
+}
+
+
+/**
+ * @brief time predictBatch + updateBatch over cfg.tracks lanes
+ * 
+ * @return (double) - nanoseconds per track per step
+*/
+double benchBatch(const BenchConfig& cfg, double& checksum) {
+    const int n = cfg.num_states;
+    const int count = cfg.tracks;
+    const KernelTable& k = kernels();
+
+    MatrixXd A1 = transition(n, 0.05);
+    vector<double> A(n * n * count);
+    vector<double> Q(n * n * count);
+    vector<double> P(n * n * count);
+    vector<double> x(n * count, 0.0);
+    vector<double> y(count);
+    vector<double> h(n, 0.0);
+    vector<double> work((n + n * n) * count + 2 * count);
+    h[0] = 1;
+
+    for(int e = 0; e < n * n; e++) {
+        const bool diag = (e % n) == (e / n);
+        for(int l = 0; l < count; l++) {
+            A[e * count + l] = A1(e % n, e / n);
+            Q[e * count + l] = diag ? 0.1 : 0;
+            P[e * count + l] = diag ? 1 : 0;
+        }
+    }
+
+    auto start = chrono::steady_clock::now();
+    for(int s = 0; s < cfg.batch_steps; s++) {
+        for(int l = 0; l < count; l++) {
+            y[l] = 0.001 * (s + l);
+        }
+        k.predictBatch(n, count, A.data(), Q.data(), x.data(), P.data(),
+            work.data());
+        k.updateBatch(n, count, h.data(), 1.0, y.data(), x.data(), P.data(),
+            nullptr, nullptr, work.data());
+    }
+    auto stop = chrono::steady_clock::now();
+
+    checksum += x[0];
+    return chrono::duration<double, nano>(stop - start).count() /
+        (static_cast<double>(cfg.batch_steps) * count);
+}
+
+
+
+/**
+ * @brief time SharedCovarianceGroup steps over cfg.tracks tracks
+ * 
+ * @return (double) - nanoseconds per track per step
+*/
+double benchShared(const BenchConfig& cfg, double& checksum) {
+    const int n = cfg.num_states;
+    MatrixXd A = transition(n, 0.05);
+    MatrixXd H = MatrixXd::Zero(1, n);
+    MatrixXd R(1, 1);
+    vector<double> y(cfg.tracks);
+    H(0, 0) = 1;
+    R << 1;
+
+    SharedCovarianceGroup group(n, 1);
+    group.setObervationMatrix(H);
+    group.setNoiseCovariance(MatrixXd::Identity(n, n) * 0.1);
+    group.setInitCovariance(MatrixXd::Identity(n, n));
+    for(int t = 0; t < cfg.tracks; t++) {
+        group.addTrack(VectorXd::Zero(n));
+    }
+
+    auto start = chrono::steady_clock::now();
+    for(int s = 0; s < cfg.batch_steps; s++) {
+        for(int l = 0; l < cfg.tracks; l++) {
+            y[l] = 0.001 * (s + l);
+        }
+        group.step(A, y, R);
+    }
+    auto stop = chrono::steady_clock::now();
+
+    checksum += group.getStateEstimate(0)[0];
+    return chrono::duration<double, nano>(stop - start).count() /
+        (static_cast<double>(cfg.batch_steps) * cfg.tracks);
+}
+
+
+
+/**
+ * @brief time predict + update of an IMM bank of 3 models
+ * 
+ * @return (double) - nanoseconds per step of the whole bank
+*/
+double benchIMM(const BenchConfig& cfg, double& checksum) {
+    const int n = cfg.num_states;
+    const int num_models = 3;
+    MatrixXd H = MatrixXd::Zero(1, n);
+    MatrixXd R(1, 1);
+    MatrixXd T = MatrixXd::Constant(num_models, num_models, 0.05);
+    VectorXd y(1);
+    H(0, 0) = 1;
+    R << 1;
+    T.diagonal().setConstant(0.9);
+
+    IMMFilter imm(num_models, n, 1);
+    imm.setObervationMatrix(H);
+    imm.setTransitionProbabilities(T);
+    imm.setInitState(VectorXd::Zero(n), MatrixXd::Identity(n, n),
+        VectorXd::Constant(num_models, 1.0 / num_models));
+    for(int k = 0; k < num_models; k++) {
+        imm.setModel(k, transition(n, 0.05 * (k + 1)),
+            MatrixXd::Identity(n, n) * 0.1 * (k + 1));
+    }
+
+    auto start = chrono::steady_clock::now();
+    for(int i = 0; i < cfg.steps; i++) {
+        imm.predict();
+        y << 0.001 * i;
+        imm.update(y, R);
+    }
+    auto stop = chrono::steady_clock::now();
+
+    checksum += imm.getStateEstimate()[0];
+    return chrono::duration<double, nano>(stop - start).count() / cfg.steps;
+}
+
+}  // namespace
+
+
+int main(int argc, char** argv) {
+    BenchConfig cfg;
+
+    try {
+        selectIsaFromArgs(argc, argv);
+        for(int i = 1; i < argc; i++) {
+            string arg = argv[i];
+            if(arg == "--all-isa") {
+                cfg.all_isa = true;
+            }
+            else if(arg == "--dense-h") {
+                cfg.dense_h = true;
+            }
+            else if(i + 1 < argc && arg == "--states") {
+                cfg.num_states = atoi(argv[++i]);
+            }
+            else if(i + 1 < argc && arg == "--steps") {
+                cfg.steps = atoi(argv[++i]);
+            }
+            else if(i + 1 < argc && arg == "--tracks") {
+                cfg.tracks = atoi(argv[++i]);
+            }
+            else if(i + 1 < argc && arg == "--batch-steps") {
+                cfg.batch_steps = atoi(argv[++i]);
+            }
+            else {
+                printUsage();
+                return arg == "--help" ? 0 : 1;
+            }
+        }
+    }
+    catch(const exception& e) {
+        cerr << e.what() << "\n";
+        return 1;
+    }
+
+    if(cfg.num_states < 1 || cfg.steps < 1 || cfg.tracks < 1 || cfg.batch_steps < 1) {
+        printUsage();
+        return 1;
+    }
+
+    vector<IsaLevel> levels;
+    if(cfg.all_isa) {
+        for(IsaLevel level : {IsaLevel::Baseline, IsaLevel::SSE42,
+                              IsaLevel::AVX2, IsaLevel::AVX512}) {
+            if(isaSupported(level)) {
+                levels.push_back(level);
+            }
+        }
+    }
+    else {
+        levels.push_back(activeIsaLevel());
+    }
+
+    cout << "Detected ISA level: " << isaName(detectIsaLevel()) << "\n";
+    cout << "States: " << cfg.num_states << ", tracks: " << cfg.tracks << "\n";
+
+    double checksum = 0;
+    for(IsaLevel level : levels) {
+        // a single run keeps the startup table, which may differ from the
+        // forced one (see kernels())
+        if(cfg.all_isa) {
+            setIsaLevel(level);
+        }
+        const double scalar_ns = benchScalar(cfg, checksum);
+        const double batch_ns = benchBatch(cfg, checksum);
+        const double shared_ns = benchShared(cfg, checksum);
+        const double imm_ns = benchIMM(cfg, checksum);
+        cout << "isa=" << kernels().name
+             << "  scalar: " << scalar_ns << " ns/step"
+             << "  batched: " << batch_ns << " ns/track-step"
+             << "  shared covariance: " << shared_ns << " ns/track-step"
+             << "  imm (3 models): " << imm_ns << " ns/step\n";
+    }
+    cout << "checksum: " << checksum << "\n";
+
+    return 0;
+}
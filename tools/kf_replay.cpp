@@ -0,0 +1,255 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @file kf_replay.cpp
+ * @author Rishabh Mukund (rishabh.m96@gmail.com)
+ * @brief Replay sensor logs in real time through a Kalman filter and report latency
+ * @version 1.0
+ * @date 18/10/2026
+ *
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+*/
+
+#include "kalman_filter.hpp"
+#include "replay.hpp"
+#include "cpu_dispatch.hpp"
+#include "shm_ring.hpp"
+
+#include<Eigen/Dense>
+#include<cmath>
+#include<cstdlib>
+#include<fstream>
+#include<iostream>
+#include<memory>
+#include<string>
+#include<vector>
+
+
+using namespace std;
+using namespace Eigen;
+
+namespace {
+
+void printUsage() {
+    cout << "usage: KalmanFilterReplay [--log <file>[:stddev]]... [--speed <1|N|max>]\n"
+         << "                          [--jitter ms] [--burst prob:len] [--reorder prob]\n"
+         << "                          [--deadline ms] [--queue N] [--seed N]\n"
+         << "                          [--latency-out file] [--publish <shm>]\n"
+         << "                          [--isa=<level>]\n"
+         << "Without --log the task 2 camera (0.5) and radar (0.01) logs are replayed.\n"
+         << "--publish writes every estimate to the shared memory ring <shm> (eg. /kf)\n"
+         << "for KalmanFilterShmTail and other readers.\n";
+}
+
+
+/**
+ * @brief split "file:stddev" into its parts, stddev defaults to 1
+*/
+void parseLog(const string& arg, vector<string>& files, vector<double>& stddevs) {
+    const size_t colon = arg.rfind(':');
+    if(colon == string::npos) {
+        files.push_back(arg);
+        stddevs.push_back(1);
+    }
+    else {
+        files.push_back(arg.substr(0, colon));
+        stddevs.push_back(stod(arg.substr(colon + 1)));
+    }
+}
+
+}  // namespace
+
+
+int main(int argc, char** argv) {
+    ReplayConfig config;
+    vector<string> files;
+    vector<double> stddevs;
+    string latency_out;
+    string publish_name;
+
+    try {
+        selectIsaFromArgs(argc, argv);
+        for(int i = 1; i < argc; i++) {
+            string arg = argv[i];
+            if(arg == "--help") {
+                printUsage();
+                return 0;
+            }
+            if(i + 1 >= argc) {
+                printUsage();
+                return 1;
+            }
+            string value = argv[++i];
+            if(arg == "--log") {
+                parseLog(value, files, stddevs);
+            }
+            else if(arg == "--speed") {
+                config.speed = value == "max" ? 0 : stod(value);
+            }
+            else if(arg == "--jitter") {
+                config.jitter_ms = stod(value);
+            }
+            else if(arg == "--burst") {
+                const size_t colon = value.find(':');
+                config.burst_prob = stod(value.substr(0, colon));
+                config.burst_len = colon == string::npos ? 4 : stoi(value.substr(colon + 1));
+            }
+            else if(arg == "--reorder") {
+                config.reorder_prob = stod(value);
+            }
+            else if(arg == "--deadline") {
+                config.deadline_ms = stod(value);
+            }
+            else if(arg == "--queue") {
+                config.queue_capacity = stoul(value);
+            }
+            else if(arg == "--seed") {
+                config.seed = stoul(value);
+            }
+            else if(arg == "--latency-out") {
+                latency_out = value;
+            }
+            else if(arg == "--publish") {
+                publish_name = value;
+            }
+            else {
+                printUsage();
+                return 1;
+            }
+        }
+    }
+    catch(const exception& e) {
+        cerr << e.what() << "\n";
+        printUsage();
+        return 1;
+    }
+
+    try {
+        if(files.empty()) {
+            files = {"../data/cam_data2.txt", "../data/rad_data2.txt"};
+            stddevs = {0.5, 0.01};
+        }
+
+        vector<SensorEvent> events = loadSensorLogs(files);
+        if(events.empty()) {
+            cerr << "No events in sensor logs.\n";
+            return 1;
+        }
+
+        int num_states = 2;        // x_pos, x_vel
+        int num_measurements = 1;  // xm_pos
+
+        MatrixXd A(num_states, num_states);
+        MatrixXd B = MatrixXd::Zero(num_states, 1);
+        MatrixXd H(num_measurements, num_states);
+        MatrixXd Q(num_states, num_states);
+        MatrixXd P = MatrixXd::Zero(num_states, num_states);
+        VectorXd x(num_states);
+        VectorXd u = VectorXd::Zero(1);
+        VectorXd y(num_measurements);
+
+        vector<MatrixXd> R(files.size(), MatrixXd(num_measurements, num_measurements));
+        for(size_t i = 0; i < files.size(); i++) {
+            R[i] << pow(stddevs[i], 2);
+        }
+
+        H << 1, 0;
+        Q << 0.06, 0.006, 0.006, 0.06;
+
+        KalmanFilter KF(num_states, num_measurements);
+        KF.setObervationMatrix(H);
+        KF.setNoiseCovariance(Q);
+
+        // Ring sized for a few seconds of events so slow readers can catch up
+        unique_ptr<ShmPublisher> publisher;
+        if(!publish_name.empty()) {
+            publisher = make_unique<ShmPublisher>(publish_name, 4096, num_states, true);
+        }
+
+        bool initialized = false;
+        double last_time = 0;
+        double estimate = 0;
+
+        auto pipeline = [&](const SensorEvent& event) {
+            if(!initialized) {
+                x << event.value, 0;
+                KF.setInitState(x, P);
+                initialized = true;
+            }
+            else {
+                double dt = (event.timestamp - last_time)/1000;
+                A << 1, dt, 0, 1;
+                KF.predict(A, B, u);
+                y << event.value;
+                KF.update(y, R[event.sensor - 1]);
+            }
+            last_time = event.timestamp;
+            estimate = KF.getStateEstimate()[0];
+            if(publisher) {
+                publisher->publish(event.timestamp, 0, KF.getStateEstimate(),
+                    KF.getCovarianceEstimate());
+            }
+        };
+
+        ReplayHarness harness(config);
+        ReplayStats stats = harness.run(events, pipeline);
+
+        cout << "Kernel ISA level: " << kernels().name << "\n";
+        cout << "Replayed " << events.size() << " events from " << files.size() << " logs at ";
+        if(config.speed > 0) {
+            cout << config.speed << "x";
+        }
+        else {
+            cout << "max speed";
+        }
+        cout << " in " << stats.wall_time_s << " s\n";
+        cout << "delivered: " << stats.delivered << ", processed: " << stats.processed
+             << ", dropped: " << stats.dropped << ", late: " << stats.late
+             << ", deadline misses: " << stats.deadline_misses << "\n";
+        cout << "latency (us): mean " << stats.mean()
+             << ", p50 " << stats.percentile(50)
+             << ", p90 " << stats.percentile(90)
+             << ", p99 " << stats.percentile(99)
+             << ", p99.9 " << stats.percentile(99.9)
+             << ", max " << stats.percentile(100) << "\n";
+        cout << "Last position estimate: " << estimate << "\n";
+
+        if(!latency_out.empty()) {
+            ofstream file(latency_out);
+            if(!file.is_open()) {
+                throw runtime_error("Failed to to open file: " + latency_out);
+            }
+            for(double latency : stats.latency_us) {
+                file << latency << "\n";
+            }
+            file.close();
+            cout << "File written successfully.\n";
+        }
+    }
+    catch(const exception& e) {
+        cerr << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,148 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @file kf_shm_tail.cpp
+ * @author Rishabh Mukund (rishabh.m96@gmail.com)
+ * @brief Print filter estimates published to a shared memory ring
+ * @version 1.0
+ * @date 18/10/2026
+ *
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+*/
+
+#include "shm_ring.hpp"
+
+#include<chrono>
+#include<cstdint>
+#include<iomanip>
+#include<iostream>
+#include<string>
+#include<thread>
+
+
+using namespace std;
+
+namespace {
+
+void printUsage() {
+    cout << "usage: KalmanFilterShmTail --name <shm> [--count N] [--from-oldest]\n"
+         << "                           [--latest] [--poll-us N]\n"
+         << "Prints records published by KalmanFilterReplay --publish <shm>.\n"
+         << "--count 0 (default) follows the ring until it is interrupted.\n";
+}
+
+
+void printRecord(const EstimateRecord& record) {
+    cout << record.index << " " << fixed << setprecision(3) << record.timestamp
+         << defaultfloat << setprecision(6) << " " << record.track_id;
+    for(int i = 0; i < record.state.size(); i++) {
+        cout << " " << record.state[i];
+    }
+    for(int i = 0; i < record.covariance.size(); i++) {
+        cout << " " << record.covariance.data()[i];
+    }
+    cout << "\n";
+}
+
+}  // namespace
+
+
+int main(int argc, char** argv) {
+    string name;
+    uint64_t count = 0;
+    bool from_oldest = false;
+    bool latest = false;
+    int poll_us = 1000;
+
+    try {
+        for(int i = 1; i < argc; i++) {
+            string arg = argv[i];
+            if(arg == "--help") {
+                printUsage();
+                return 0;
+            }
+            if(arg == "--from-oldest") {
+                from_oldest = true;
+                continue;
+            }
+            if(arg == "--latest") {
+                latest = true;
+                continue;
+            }
+            if(i + 1 >= argc) {
+                printUsage();
+                return 1;
+            }
+            string value = argv[++i];
+            if(arg == "--name") {
+                name = value;
+            }
+            else if(arg == "--count") {
+                count = stoull(value);
+            }
+            else if(arg == "--poll-us") {
+                poll_us = stoi(value);
+            }
+            else {
+                printUsage();
+                return 1;
+            }
+        }
+        if(name.empty()) {
+            printUsage();
+            return 1;
+        }
+
+        ShmReader reader(name, from_oldest);
+        EstimateRecord record;
+
+        if(latest) {
+            if(!reader.latest(record)) {
+                cerr << "Nothing published to " << name << " yet.\n";
+                return 1;
+            }
+            printRecord(record);
+            return 0;
+        }
+
+        uint64_t printed = 0;
+        while(count == 0 || printed < count) {
+            if(reader.next(record)) {
+                printRecord(record);
+                printed++;
+            }
+            else {
+                this_thread::sleep_for(chrono::microseconds(poll_us));
+            }
+        }
+        if(reader.overruns() > 0) {
+            cerr << "Skipped " << reader.overruns() << " overwritten records.\n";
+        }
+    }
+    catch(const exception& e) {
+        cerr << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}